@@ -0,0 +1,218 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_CORE_EVENT_CALLBACK_HPP
+#define NFD_CORE_EVENT_CALLBACK_HPP
+
+#include "common.hpp"
+
+#include <type_traits>
+
+namespace nfd {
+namespace scheduler {
+
+/** \brief a move-only void() callable with inline storage
+ *
+ *  Unlike std::function, EventCallback stores callables of up to INLINE_SIZE bytes inline,
+ *  which covers the daemon's common captures such as
+ *  bind(&Forwarder::onInterestUnsatisfied, this, shared_ptr<pit::Entry>).
+ *  Larger callables are allocated on the heap.
+ */
+class EventCallback : noncopyable
+{
+public:
+  static const size_t INLINE_SIZE = 48;
+
+  EventCallback()
+    : m_ops(nullptr)
+  {
+  }
+
+  template<typename F,
+           typename = typename std::enable_if<
+             !std::is_same<typename std::decay<F>::type, EventCallback>::value>::type>
+  explicit
+  EventCallback(F&& f)
+    : m_ops(nullptr)
+  {
+    this->emplace<typename std::decay<F>::type>(std::forward<F>(f));
+  }
+
+  EventCallback(EventCallback&& other)
+    : m_ops(other.m_ops)
+  {
+    if (m_ops != nullptr) {
+      m_ops->move(&m_storage, &other.m_storage);
+      other.m_ops = nullptr;
+    }
+  }
+
+  EventCallback&
+  operator=(EventCallback&& other)
+  {
+    if (this != &other) {
+      this->reset();
+      m_ops = other.m_ops;
+      if (m_ops != nullptr) {
+        m_ops->move(&m_storage, &other.m_storage);
+        other.m_ops = nullptr;
+      }
+    }
+    return *this;
+  }
+
+  ~EventCallback()
+  {
+    this->reset();
+  }
+
+  explicit
+  operator bool() const
+  {
+    return m_ops != nullptr;
+  }
+
+  /** \brief invoke the callable
+   *  \pre *this is not empty
+   */
+  void
+  operator()()
+  {
+    BOOST_ASSERT(m_ops != nullptr);
+    m_ops->invoke(&m_storage);
+  }
+
+  /** \brief destroy the callable
+   */
+  void
+  reset()
+  {
+    if (m_ops != nullptr) {
+      m_ops->destroy(&m_storage);
+      m_ops = nullptr;
+    }
+  }
+
+private:
+  typedef std::aligned_storage<INLINE_SIZE>::type Storage;
+
+  struct Ops
+  {
+    void (*invoke)(void* storage);
+    void (*move)(void* dst, void* src); ///< move-construct dst from src, then destroy src
+    void (*destroy)(void* storage);
+  };
+
+  template<typename F>
+  struct InlineOps
+  {
+    static void
+    invoke(void* storage)
+    {
+      (*static_cast<F*>(storage))();
+    }
+
+    static void
+    move(void* dst, void* src)
+    {
+      new (dst) F(std::move(*static_cast<F*>(src)));
+      static_cast<F*>(src)->~F();
+    }
+
+    static void
+    destroy(void* storage)
+    {
+      static_cast<F*>(storage)->~F();
+    }
+
+    static const Ops ops;
+  };
+
+  template<typename F>
+  struct HeapOps
+  {
+    static void
+    invoke(void* storage)
+    {
+      (**static_cast<F**>(storage))();
+    }
+
+    static void
+    move(void* dst, void* src)
+    {
+      *static_cast<F**>(dst) = *static_cast<F**>(src);
+    }
+
+    static void
+    destroy(void* storage)
+    {
+      delete *static_cast<F**>(storage);
+    }
+
+    static const Ops ops;
+  };
+
+  template<typename F>
+  struct IsInline : std::integral_constant<bool,
+                      sizeof(F) <= sizeof(Storage) &&
+                      std::alignment_of<Storage>::value % std::alignment_of<F>::value == 0>
+  {
+  };
+
+  template<typename F, typename A>
+  typename std::enable_if<IsInline<F>::value>::type
+  emplace(A&& f)
+  {
+    new (&m_storage) F(std::forward<A>(f));
+    m_ops = &InlineOps<F>::ops;
+  }
+
+  template<typename F, typename A>
+  typename std::enable_if<!IsInline<F>::value>::type
+  emplace(A&& f)
+  {
+    *reinterpret_cast<F**>(&m_storage) = new F(std::forward<A>(f));
+    m_ops = &HeapOps<F>::ops;
+  }
+
+private:
+  Storage m_storage;
+  const Ops* m_ops;
+};
+
+template<typename F>
+const EventCallback::Ops EventCallback::InlineOps<F>::ops = {
+  &InlineOps<F>::invoke, &InlineOps<F>::move, &InlineOps<F>::destroy
+};
+
+template<typename F>
+const EventCallback::Ops EventCallback::HeapOps<F>::ops = {
+  &HeapOps<F>::invoke, &HeapOps<F>::move, &HeapOps<F>::destroy
+};
+
+} // namespace scheduler
+} // namespace nfd
+
+#endif // NFD_CORE_EVENT_CALLBACK_HPP
@@ -0,0 +1,226 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_CORE_MPSC_QUEUE_HPP
+#define NFD_CORE_MPSC_QUEUE_HPP
+
+#include "common.hpp"
+
+#include <atomic>
+#include <limits>
+
+namespace nfd {
+
+/** \brief bounded lock-free queue with multiple producers and a single consumer
+ *
+ *  The queue is a ring of cells, each carrying a sequence number that tells whether the cell
+ *  is free for the producer at a given position or holds an item for the consumer.
+ *  Producers claim positions with compare-and-swap; the consumer needs no atomic
+ *  read-modify-write.
+ *
+ *  When the queue is full, push drops the new item (drop-tail) and counts it.
+ *
+ *  The consumer may register a wakeup callback. After popBatch finds the queue empty,
+ *  the next successful push invokes the callback once, on the producer's thread.
+ *  The callback would typically signal an eventfd or post to the consumer's event loop.
+ *
+ *  \tparam T item type, which must be default-constructible and move-assignable
+ */
+template<typename T>
+class MpscQueue : noncopyable
+{
+public:
+  typedef std::function<void()> WakeupCallback;
+
+  /** \param capacity maximum number of queued items, rounded up to a power of two
+   *  \param wakeup callback invoked when an item is pushed into a drained queue
+   */
+  explicit
+  MpscQueue(size_t capacity, const WakeupCallback& wakeup = WakeupCallback());
+
+  /** \brief enqueue an item; may be called from any thread
+   *  \retval true the item is queued
+   *  \retval false the queue is full and the item is dropped
+   */
+  bool
+  push(T&& item);
+
+  /** \brief dequeue up to \p maxItems items in FIFO order; must be called from the consumer thread
+   *  \param f function invoked with each item as an rvalue
+   *  \return number of items dequeued
+   */
+  template<typename F>
+  size_t
+  popBatch(const F& f, size_t maxItems = std::numeric_limits<size_t>::max());
+
+  size_t
+  capacity() const
+  {
+    return m_mask + 1;
+  }
+
+  /** \return number of items dropped because the queue was full
+   */
+  uint64_t
+  getNDropped() const
+  {
+    return m_nDropped.load(std::memory_order_relaxed);
+  }
+
+private:
+  /** \brief pop ready items without arming the wakeup
+   */
+  template<typename F>
+  size_t
+  popReady(const F& f, size_t maxItems);
+
+  bool
+  isHeadReady() const
+  {
+    const Cell& cell = m_cells[m_dequeuePos & m_mask];
+    return cell.sequence.load(std::memory_order_acquire) == m_dequeuePos + 1;
+  }
+
+  static size_t
+  roundUpToPowerOfTwo(size_t n)
+  {
+    size_t result = 1;
+    while (result < n)
+      result <<= 1;
+    return result;
+  }
+
+private:
+  struct Cell
+  {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  static const size_t CACHE_LINE_SIZE = 64;
+
+  const size_t m_mask;
+  unique_ptr<Cell[]> m_cells;
+  WakeupCallback m_wakeup;
+
+  // producers and consumer positions are kept on separate cache lines
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_enqueuePos;
+  alignas(CACHE_LINE_SIZE) size_t m_dequeuePos;
+  std::atomic<bool> m_isWakeupArmed;
+  std::atomic<uint64_t> m_nDropped;
+};
+
+template<typename T>
+MpscQueue<T>::MpscQueue(size_t capacity, const WakeupCallback& wakeup)
+  : m_mask(roundUpToPowerOfTwo(std::max<size_t>(capacity, 2)) - 1)
+  , m_cells(new Cell[m_mask + 1])
+  , m_wakeup(wakeup)
+  , m_enqueuePos(0)
+  , m_dequeuePos(0)
+  , m_isWakeupArmed(true)
+  , m_nDropped(0)
+{
+  for (size_t i = 0; i <= m_mask; ++i)
+    m_cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+template<typename T>
+bool
+MpscQueue<T>::push(T&& item)
+{
+  Cell* cell = nullptr;
+  size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+  while (true) {
+    cell = &m_cells[pos & m_mask];
+    size_t sequence = cell->sequence.load(std::memory_order_acquire);
+    intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+    if (diff == 0) {
+      if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        break;
+    }
+    else if (diff < 0) {
+      // the cell still holds an item from the previous lap: queue is full
+      m_nDropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    else {
+      pos = m_enqueuePos.load(std::memory_order_relaxed);
+    }
+  }
+
+  cell->value = std::move(item);
+  cell->sequence.store(pos + 1, std::memory_order_release);
+
+  // pairs with the fence in popBatch, so that either the consumer sees this item
+  // or this producer sees the armed wakeup
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (m_isWakeupArmed.load(std::memory_order_relaxed) &&
+      m_isWakeupArmed.exchange(false, std::memory_order_acq_rel) &&
+      m_wakeup) {
+    m_wakeup();
+  }
+  return true;
+}
+
+template<typename T>
+template<typename F>
+size_t
+MpscQueue<T>::popReady(const F& f, size_t maxItems)
+{
+  size_t nPopped = 0;
+  while (nPopped < maxItems && isHeadReady()) {
+    Cell& cell = m_cells[m_dequeuePos & m_mask];
+    T item = std::move(cell.value);
+    cell.value = T();
+    cell.sequence.store(m_dequeuePos + m_mask + 1, std::memory_order_release);
+    ++m_dequeuePos;
+    ++nPopped;
+
+    f(std::move(item));
+  }
+  return nPopped;
+}
+
+template<typename T>
+template<typename F>
+size_t
+MpscQueue<T>::popBatch(const F& f, size_t maxItems)
+{
+  size_t nPopped = popReady(f, maxItems);
+  if (nPopped == maxItems)
+    return nPopped;
+
+  // queue is drained: arm the wakeup, then check again for an item pushed in the meantime
+  m_isWakeupArmed.store(true, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (isHeadReady() && m_isWakeupArmed.exchange(false, std::memory_order_acq_rel))
+    nPopped += popBatch(f, maxItems - nPopped);
+
+  return nPopped;
+}
+
+} // namespace nfd
+
+#endif // NFD_CORE_MPSC_QUEUE_HPP
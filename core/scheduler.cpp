@@ -24,43 +24,49 @@
  */
 
 #include "scheduler.hpp"
+#include "timer-wheel.hpp"
 
-namespace ns3 {
-
-/// @cond include_hidden
+namespace nfd {
+namespace scheduler {
 
-template<>
-struct EventMemberImplObjTraits<std::function<void()>> {
-  typedef std::function<void()> T;
-  static T&
-  GetReference(T& p)
-  {
-    return p;
+/** \return timer wheel of the current simulation context
+ */
+static TimerWheel&
+getTimerWheel()
+{
+  static std::unordered_map<uint32_t, unique_ptr<TimerWheel>> wheels;
+  static uint32_t lastContext = 0;
+  static TimerWheel* lastWheel = nullptr;
+
+  uint32_t context = ns3::Simulator::GetContext();
+  if (lastWheel == nullptr || context != lastContext) {
+    unique_ptr<TimerWheel>& wheel = wheels[context];
+    if (wheel == nullptr) {
+      wheel.reset(new TimerWheel);
+    }
+    lastContext = context;
+    lastWheel = wheel.get();
   }
-};
-
-/// @endcond
-
-} // namespace ns3
+  return *lastWheel;
+}
 
-namespace nfd {
-namespace scheduler {
+std::ostream&
+operator<<(std::ostream& os, const EventId& eventId)
+{
+  return os << eventId.m_index << '#' << eventId.m_generation;
+}
 
 EventId
-schedule(const time::nanoseconds& after, const std::function<void()>& event)
+schedule(const time::nanoseconds& after, EventCallback&& event)
 {
-  ns3::EventId id = ns3::Simulator::Schedule(ns3::NanoSeconds(after.count()),
-                                             &std::function<void()>::operator(), event);
-  return std::make_shared<ns3::EventId>(id);
+  return getTimerWheel().schedule(after, std::move(event));
 }
 
 void
 cancel(const EventId& eventId)
 {
-  if (eventId != nullptr) {
-    ns3::Simulator::Remove(*eventId);
-    const_cast<EventId&>(eventId).reset();
-  }
+  TimerWheel::cancel(eventId);
+  const_cast<EventId&>(eventId).reset();
 }
 
 ScopedEventId::ScopedEventId()
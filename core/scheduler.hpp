@@ -28,22 +28,102 @@
 
 #include "common.hpp"
 
+#include "event-callback.hpp"
+
 #include "ns3/simulator.h"
 
 namespace nfd {
 namespace scheduler {
 
-/** \class EventId
- *  \brief Opaque type (shared_ptr) representing ID of a scheduled event
+class TimerWheel;
+
+/** \brief identifies a scheduled event
+ *
+ *  EventId is a generation-tagged index into the pool of timer records.
+ *  It stays valid after the event fires or is cancelled; cancelling through
+ *  a stale EventId has no effect.
+ */
+class EventId
+{
+public:
+  /** \brief constructs an empty EventId
+   */
+  EventId()
+    : m_index(0)
+    , m_generation(0)
+  {
+  }
+
+  /** \retval true EventId was returned by schedule and has not been reset
+   */
+  explicit
+  operator bool() const
+  {
+    return m_generation != 0;
+  }
+
+  /** \brief clears this EventId, without cancelling the event
+   */
+  void
+  reset()
+  {
+    m_index = 0;
+    m_generation = 0;
+  }
+
+  bool
+  operator==(const EventId& other) const
+  {
+    return m_index == other.m_index && m_generation == other.m_generation;
+  }
+
+  bool
+  operator!=(const EventId& other) const
+  {
+    return !(*this == other);
+  }
+
+private:
+  EventId(uint32_t index, uint32_t generation)
+    : m_index(index)
+    , m_generation(generation)
+  {
+  }
+
+private:
+  uint32_t m_index;
+  uint32_t m_generation;
+
+  friend class TimerWheel;
+  friend std::ostream& operator<<(std::ostream&, const EventId&);
+};
+
+std::ostream&
+operator<<(std::ostream& os, const EventId& eventId);
+
+/** \brief schedule an event
+ *
+ *  The event is placed in the timer wheel of the current simulation context,
+ *  and reaches the simulator event queue only shortly before it expires.
  */
-typedef std::shared_ptr<ns3::EventId> EventId;
+EventId
+schedule(const time::nanoseconds& after, EventCallback&& event);
 
 /** \brief schedule an event
+ *
+ *  \p event is stored inline in the timer record if it fits EventCallback::INLINE_SIZE,
+ *  so that scheduling does not allocate memory.
  */
+template<typename F>
 EventId
-schedule(const time::nanoseconds& after, const std::function<void()>& event);
+schedule(const time::nanoseconds& after, F&& event)
+{
+  return schedule(after, EventCallback(std::forward<F>(event)));
+}
 
 /** \brief cancel a scheduled event
+ *
+ *  \p eventId is reset to empty.
  */
 void
 cancel(const EventId& eventId);
@@ -0,0 +1,398 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "timer-wheel.hpp"
+
+namespace nfd {
+namespace scheduler {
+
+const time::nanoseconds TimerWheel::RESOLUTION = time::milliseconds(1);
+
+static inline int64_t
+toTick(const ns3::Time& t)
+{
+  return t.GetNanoSeconds() / TimerWheel::RESOLUTION.count();
+}
+
+TimerEntry::TimerEntry()
+  : m_index(0)
+  , m_generation(1)
+  , m_state(TIMER_FREE)
+  , m_wheel(nullptr)
+  , m_level(-1)
+  , m_slot(-1)
+  , m_prev(nullptr)
+  , m_next(nullptr)
+{
+}
+
+void
+TimerWheel::TimerList::pushBack(TimerEntry* timer)
+{
+  timer->m_prev = tail;
+  timer->m_next = nullptr;
+  if (tail == nullptr) {
+    head = timer;
+  }
+  else {
+    tail->m_next = timer;
+  }
+  tail = timer;
+}
+
+void
+TimerWheel::TimerList::erase(TimerEntry* timer)
+{
+  if (timer->m_prev == nullptr) {
+    head = timer->m_next;
+  }
+  else {
+    timer->m_prev->m_next = timer->m_next;
+  }
+  if (timer->m_next == nullptr) {
+    tail = timer->m_prev;
+  }
+  else {
+    timer->m_next->m_prev = timer->m_prev;
+  }
+  timer->m_prev = timer->m_next = nullptr;
+}
+
+TimerWheel::Pool&
+TimerWheel::getPool()
+{
+  static Pool pool;
+  return pool;
+}
+
+TimerEntry*
+TimerWheel::allocate()
+{
+  Pool& pool = getPool();
+  TimerEntry* timer = pool.freeList;
+  if (timer != nullptr) {
+    pool.freeList = timer->m_next;
+    timer->m_next = nullptr;
+  }
+  else {
+    uint32_t index = static_cast<uint32_t>(pool.entries.size());
+    pool.entries.emplace_back();
+    timer = &pool.entries.back();
+    timer->m_index = index;
+  }
+  return timer;
+}
+
+void
+TimerWheel::release(TimerEntry* timer)
+{
+  Pool& pool = getPool();
+  // the callback is destroyed only after the record is free, because
+  // destructors of its captures may cancel this very timer
+  EventCallback callback(std::move(timer->m_callback));
+  timer->m_state = TimerEntry::TIMER_FREE;
+  timer->m_wheel = nullptr;
+  timer->m_simEvent = ns3::EventId();
+  if (++timer->m_generation == 0) { // 0 is reserved for empty EventId
+    timer->m_generation = 1;
+  }
+  timer->m_prev = nullptr;
+  timer->m_next = pool.freeList;
+  pool.freeList = timer;
+}
+
+TimerEntry*
+TimerWheel::find(const EventId& eventId)
+{
+  Pool& pool = getPool();
+  if (!eventId || eventId.m_index >= pool.entries.size()) {
+    return nullptr;
+  }
+
+  TimerEntry* timer = &pool.entries[eventId.m_index];
+  if (timer->m_generation != eventId.m_generation || timer->m_state == TimerEntry::TIMER_FREE) {
+    return nullptr;
+  }
+  return timer;
+}
+
+TimerWheel::TimerWheel()
+  : m_nTimers(0)
+  , m_currentTick(0)
+  , m_scheduledTick(-1)
+  , m_hasDestroyHook(false)
+{
+  std::fill_n(m_occupied, LEVELS, 0);
+}
+
+EventId
+TimerWheel::schedule(const time::nanoseconds& after, EventCallback&& callback)
+{
+  if (!m_hasDestroyHook) {
+    ns3::Simulator::ScheduleDestroy(&TimerWheel::reset, this);
+    m_hasDestroyHook = true;
+  }
+
+  this->advance();
+
+  TimerEntry* timer = allocate();
+  timer->m_deadline = ns3::Simulator::Now() + ns3::NanoSeconds(after.count());
+  timer->m_callback = std::move(callback);
+  timer->m_wheel = this;
+  EventId eventId(timer->m_index, timer->m_generation);
+  this->insert(timer);
+
+  this->scheduleTick();
+  return eventId;
+}
+
+void
+TimerWheel::cancel(const EventId& eventId)
+{
+  TimerEntry* timer = find(eventId);
+  if (timer == nullptr) {
+    return;
+  }
+
+  TimerWheel& wheel = *timer->m_wheel;
+  switch (timer->m_state) {
+  case TimerEntry::TIMER_IN_WHEEL: {
+    int level = timer->m_level;
+    int slot = timer->m_slot;
+    wheel.m_slots[level][slot].erase(timer);
+    if (wheel.m_slots[level][slot].empty()) {
+      wheel.m_occupied[level] &= ~(uint64_t(1) << slot);
+    }
+    --wheel.m_nTimers;
+    // m_tickEvent is left as is; if the wheel became empty it'll be a no-op
+    break;
+  }
+  case TimerEntry::TIMER_PROMOTED:
+    wheel.m_promoted.erase(timer);
+    ns3::Simulator::Remove(timer->m_simEvent);
+    break;
+  case TimerEntry::TIMER_FREE:
+    BOOST_ASSERT(false);
+    break;
+  }
+  release(timer);
+}
+
+void
+TimerWheel::insert(TimerEntry* timer)
+{
+  int64_t tick = toTick(timer->m_deadline);
+  if (tick <= m_currentTick) {
+    this->promote(timer);
+    return;
+  }
+
+  int64_t diff = tick - m_currentTick;
+  int level = 0;
+  while (level < LEVELS && (diff >> (SLOT_BITS * (level + 1))) != 0) {
+    ++level;
+  }
+  if (level == LEVELS) {
+    // beyond the top level: park in the farthest top-level slot, to be re-inserted at cascade
+    level = LEVELS - 1;
+    tick = m_currentTick + (int64_t(1) << (SLOT_BITS * LEVELS)) - 1;
+  }
+  int slot = (tick >> (SLOT_BITS * level)) & (N_SLOTS - 1);
+
+  timer->m_state = TimerEntry::TIMER_IN_WHEEL;
+  timer->m_level = level;
+  timer->m_slot = slot;
+  m_slots[level][slot].pushBack(timer);
+  m_occupied[level] |= uint64_t(1) << slot;
+  ++m_nTimers;
+}
+
+void
+TimerWheel::promote(TimerEntry* timer)
+{
+  ns3::Time delay = timer->m_deadline - ns3::Simulator::Now();
+  if (delay.IsNegative()) {
+    delay = ns3::Time(0);
+  }
+
+  timer->m_state = TimerEntry::TIMER_PROMOTED;
+  timer->m_level = -1;
+  timer->m_slot = -1;
+  m_promoted.pushBack(timer);
+  timer->m_simEvent = ns3::Simulator::Schedule(delay, &TimerWheel::expire,
+                                               timer->m_index, timer->m_generation);
+}
+
+TimerWheel::TimerList
+TimerWheel::takeSlot(int level, int slot)
+{
+  TimerList timers = m_slots[level][slot];
+  m_slots[level][slot] = TimerList();
+  m_occupied[level] &= ~(uint64_t(1) << slot);
+  for (TimerEntry* timer = timers.head; timer != nullptr; timer = timer->m_next) {
+    --m_nTimers;
+  }
+  return timers;
+}
+
+int64_t
+TimerWheel::findNextTick() const
+{
+  int64_t nextTick = -1;
+  for (int level = 0; level < LEVELS; ++level) {
+    uint64_t occupied = m_occupied[level];
+    if (occupied == 0) {
+      continue;
+    }
+
+    // slots of this level are processed at multiples of N_SLOTS^level;
+    // find the first occupied slot after the current one, in rotation order
+    int shift = SLOT_BITS * level;
+    int64_t base = m_currentTick >> shift;
+    int rot = static_cast<int>((base + 1) & (N_SLOTS - 1));
+    uint64_t rotated = rot == 0 ? occupied : (occupied >> rot) | (occupied << (N_SLOTS - rot));
+    int64_t j = __builtin_ctzll(rotated) + 1;
+    int64_t tick = (base + j) << shift;
+
+    if (nextTick < 0 || tick < nextTick) {
+      nextTick = tick;
+    }
+  }
+  return nextTick;
+}
+
+void
+TimerWheel::processTick(int64_t tick)
+{
+  BOOST_ASSERT(tick > m_currentTick);
+  m_currentTick = tick;
+
+  // cascade from the highest level, so that timers moving down are picked up by lower levels
+  for (int level = LEVELS - 1; level > 0; --level) {
+    int shift = SLOT_BITS * level;
+    if ((tick & ((int64_t(1) << shift) - 1)) != 0) {
+      continue;
+    }
+
+    TimerList timers = this->takeSlot(level, (tick >> shift) & (N_SLOTS - 1));
+    for (TimerEntry* timer = timers.head; timer != nullptr;) {
+      TimerEntry* next = timer->m_next;
+      this->insert(timer);
+      timer = next;
+    }
+  }
+
+  TimerList timers = this->takeSlot(0, tick & (N_SLOTS - 1));
+  for (TimerEntry* timer = timers.head; timer != nullptr;) {
+    TimerEntry* next = timer->m_next;
+    this->promote(timer);
+    timer = next;
+  }
+}
+
+void
+TimerWheel::advance()
+{
+  int64_t nowTick = toTick(ns3::Simulator::Now());
+  BOOST_ASSERT(nowTick >= m_currentTick);
+
+  int64_t nextTick = this->findNextTick();
+  while (nextTick >= 0 && nextTick <= nowTick) {
+    this->processTick(nextTick);
+    nextTick = this->findNextTick();
+  }
+  m_currentTick = nowTick;
+}
+
+void
+TimerWheel::scheduleTick()
+{
+  int64_t nextTick = this->findNextTick();
+  if (nextTick < 0 || (m_scheduledTick >= 0 && m_scheduledTick <= nextTick)) {
+    return;
+  }
+
+  if (m_scheduledTick >= 0) {
+    ns3::Simulator::Remove(m_tickEvent);
+  }
+  ns3::Time delay = ns3::NanoSeconds(nextTick * RESOLUTION.count()) - ns3::Simulator::Now();
+  if (delay.IsNegative()) {
+    delay = ns3::Time(0);
+  }
+  m_tickEvent = ns3::Simulator::Schedule(delay, &TimerWheel::onTick, this);
+  m_scheduledTick = nextTick;
+}
+
+void
+TimerWheel::onTick()
+{
+  m_scheduledTick = -1;
+  this->advance();
+  this->scheduleTick();
+}
+
+void
+TimerWheel::expire(uint32_t index, uint32_t generation)
+{
+  TimerEntry* timer = find(EventId(index, generation));
+  if (timer == nullptr || timer->m_state != TimerEntry::TIMER_PROMOTED) {
+    return;
+  }
+
+  // recycle the record before invoking the callback, which may schedule or cancel events
+  timer->m_wheel->m_promoted.erase(timer);
+  EventCallback callback(std::move(timer->m_callback));
+  release(timer);
+  callback();
+}
+
+void
+TimerWheel::reset()
+{
+  for (int level = 0; level < LEVELS; ++level) {
+    for (TimerList& timers : m_slots[level]) {
+      while (!timers.empty()) {
+        TimerEntry* timer = timers.head;
+        timers.erase(timer);
+        release(timer);
+      }
+    }
+    m_occupied[level] = 0;
+  }
+  while (!m_promoted.empty()) {
+    // simulator events of promoted timers are being destroyed along with the simulator
+    TimerEntry* timer = m_promoted.head;
+    m_promoted.erase(timer);
+    release(timer);
+  }
+  m_nTimers = 0;
+  m_currentTick = 0;
+  m_scheduledTick = -1;
+  m_tickEvent = ns3::EventId();
+  m_hasDestroyHook = false;
+}
+
+} // namespace scheduler
+} // namespace nfd
@@ -0,0 +1,236 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_CORE_TIMER_WHEEL_HPP
+#define NFD_CORE_TIMER_WHEEL_HPP
+
+#include "scheduler.hpp"
+
+#include <deque>
+
+namespace nfd {
+namespace scheduler {
+
+/** \brief a timer record in the pool shared by all TimerWheels
+ */
+class TimerEntry : noncopyable
+{
+public:
+  enum State {
+    TIMER_FREE,      ///< on the free list
+    TIMER_IN_WHEEL,  ///< parked in a TimerWheel slot
+    TIMER_PROMOTED   ///< handed to the simulator, awaiting expiry
+  };
+
+  TimerEntry();
+
+private:
+  uint32_t m_index; ///< position in the pool
+  uint32_t m_generation; ///< incremented when the record is recycled
+  State m_state;
+  ns3::Time m_deadline;
+  EventCallback m_callback;
+
+  TimerWheel* m_wheel;
+  int m_level; ///< wheel level, or -1 if promoted
+  int m_slot;
+  TimerEntry* m_prev; ///< doubly linked list of timers in the same slot, or free list
+  TimerEntry* m_next;
+  ns3::EventId m_simEvent;
+
+  friend class TimerWheel;
+};
+
+/** \brief hierarchical timer wheel in front of the simulator event queue
+ *
+ *  Most daemon-internal timers (PIT unsatisfy and straggler timers, strategy retransmission
+ *  timers, Measurements cleanup, CS staleness) are cancelled long before they expire.
+ *  TimerWheel parks such timers in a hierarchy of LEVELS wheels of N_SLOTS slots each,
+ *  where a slot at level k spans RESOLUTION * N_SLOTS^k.
+ *  Only one simulator event is registered for the earliest occupied slot;
+ *  cancelling a parked timer never touches the simulator.
+ *
+ *  When the slot holding a timer comes due, the timer is promoted:
+ *  it's scheduled in the simulator at its exact deadline,
+ *  so that expiry times are not rounded to the wheel resolution.
+ *
+ *  There is one TimerWheel per simulation context (i.e. per node).
+ *  Timer records come from a pool shared by all wheels and are recycled after
+ *  the timer fires or is cancelled, so that scheduling does not allocate memory
+ *  once the pool has grown to the working set.
+ */
+class TimerWheel : noncopyable
+{
+public:
+  TimerWheel();
+
+  /** \brief schedule \p callback to be invoked after \p after
+   */
+  EventId
+  schedule(const time::nanoseconds& after, EventCallback&& callback);
+
+  /** \brief cancel a timer
+   *
+   *  The timer may belong to the wheel of any simulation context.
+   *  This has no effect if the timer has fired or has been cancelled.
+   */
+  static void
+  cancel(const EventId& eventId);
+
+  /** \return number of timers parked in the wheel, excluding promoted timers
+   */
+  size_t
+  size() const
+  {
+    return m_nTimers;
+  }
+
+public:
+  static const int LEVELS = 4;
+  static const int SLOT_BITS = 6;
+  static const int N_SLOTS = 1 << SLOT_BITS;
+
+  /** \brief duration of a level-0 slot
+   *
+   *  Timers expiring within the current slot bypass the wheel.
+   */
+  static const time::nanoseconds RESOLUTION;
+
+private:
+  /** \brief doubly linked list of TimerEntry
+   */
+  struct TimerList
+  {
+    TimerList()
+      : head(nullptr)
+      , tail(nullptr)
+    {
+    }
+
+    bool
+    empty() const
+    {
+      return head == nullptr;
+    }
+
+    void
+    pushBack(TimerEntry* timer);
+
+    void
+    erase(TimerEntry* timer);
+
+    TimerEntry* head;
+    TimerEntry* tail;
+  };
+
+  /** \brief timer record pool
+   */
+  struct Pool
+  {
+    std::deque<TimerEntry> entries; ///< deque never relocates existing elements
+    TimerEntry* freeList = nullptr;
+  };
+
+  static Pool&
+  getPool();
+
+  static TimerEntry*
+  allocate();
+
+  static void
+  release(TimerEntry* timer);
+
+  /** \return the timer referenced by \p eventId, or nullptr if it has fired or has been cancelled
+   */
+  static TimerEntry*
+  find(const EventId& eventId);
+
+  /** \brief place a timer into the wheel relative to m_currentTick,
+   *         or promote it if its tick has been processed
+   */
+  void
+  insert(TimerEntry* timer);
+
+  /** \brief move timer from the wheel to the simulator event queue
+   */
+  void
+  promote(TimerEntry* timer);
+
+  /** \brief remove all timers from a slot
+   */
+  TimerList
+  takeSlot(int level, int slot);
+
+  /** \return the earliest tick after m_currentTick at which a slot needs processing,
+   *          or -1 if the wheel is empty
+   */
+  int64_t
+  findNextTick() const;
+
+  /** \brief cascade and promote timers in all slots due at \p tick
+   */
+  void
+  processTick(int64_t tick);
+
+  /** \brief process all ticks up to current simulation time
+   */
+  void
+  advance();
+
+  /** \brief ensure the simulator event is set for the earliest tick to be processed
+   */
+  void
+  scheduleTick();
+
+  void
+  onTick();
+
+  static void
+  expire(uint32_t index, uint32_t generation);
+
+  /** \brief drop all timers
+   *
+   *  This is invoked when the simulator is destroyed,
+   *  so that a subsequent simulation starts with an empty wheel.
+   */
+  void
+  reset();
+
+private:
+  TimerList m_slots[LEVELS][N_SLOTS];
+  uint64_t m_occupied[LEVELS]; ///< bitmap of non-empty slots per level
+  size_t m_nTimers;
+  TimerList m_promoted;
+
+  int64_t m_currentTick; ///< all ticks up to and including this one have been processed
+  int64_t m_scheduledTick; ///< tick of m_tickEvent, or -1 if not scheduled
+  ns3::EventId m_tickEvent;
+  bool m_hasDestroyHook;
+};
+
+} // namespace scheduler
+} // namespace nfd
+
+#endif // NFD_CORE_TIMER_WHEEL_HPP
@@ -0,0 +1,150 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "datagram-batch.hpp"
+
+#include <cerrno>
+
+namespace nfd {
+
+const size_t DatagramBatch::MAX_BATCH_SIZE;
+
+static bool
+isWouldBlock(int errorNumber)
+{
+  return errorNumber == EAGAIN || errorNumber == EWOULDBLOCK;
+}
+
+DatagramBatch::DatagramBatch()
+  : m_storage(MAX_BATCH_SIZE * ndn::MAX_NDN_PACKET_SIZE)
+{
+#ifdef __linux__
+  for (size_t i = 0; i < MAX_BATCH_SIZE; ++i) {
+    m_iovecs[i].iov_base = m_storage.data() + i * ndn::MAX_NDN_PACKET_SIZE;
+    m_iovecs[i].iov_len = ndn::MAX_NDN_PACKET_SIZE;
+  }
+#endif
+}
+
+size_t
+DatagramBatch::receive(int fd, boost::system::error_code& error)
+{
+#ifdef __linux__
+  for (size_t i = 0; i < MAX_BATCH_SIZE; ++i) {
+    msghdr& hdr = m_messages[i].msg_hdr;
+    std::memset(&hdr, 0, sizeof(hdr));
+    hdr.msg_name = &m_sources[i];
+    hdr.msg_namelen = sizeof(m_sources[i]);
+    hdr.msg_iov = &m_iovecs[i];
+    hdr.msg_iovlen = 1;
+  }
+
+  int nReceived = ::recvmmsg(fd, m_messages, MAX_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+  if (nReceived < 0) {
+    if (!isWouldBlock(errno))
+      error.assign(errno, boost::system::system_category());
+    return 0;
+  }
+
+  for (int i = 0; i < nReceived; ++i) {
+    m_sizes[i] = m_messages[i].msg_len;
+    m_sourceLengths[i] = m_messages[i].msg_hdr.msg_namelen;
+  }
+  return static_cast<size_t>(nReceived);
+#else
+  size_t nReceived = 0;
+  for (; nReceived < MAX_BATCH_SIZE; ++nReceived) {
+    m_sourceLengths[nReceived] = sizeof(m_sources[nReceived]);
+    ssize_t size = ::recvfrom(fd, m_storage.data() + nReceived * ndn::MAX_NDN_PACKET_SIZE,
+                              ndn::MAX_NDN_PACKET_SIZE, MSG_DONTWAIT,
+                              reinterpret_cast<sockaddr*>(&m_sources[nReceived]),
+                              &m_sourceLengths[nReceived]);
+    if (size < 0) {
+      // report an error only if nothing has been received, otherwise it will recur next time
+      if (!isWouldBlock(errno) && nReceived == 0)
+        error.assign(errno, boost::system::system_category());
+      break;
+    }
+    m_sizes[nReceived] = static_cast<size_t>(size);
+  }
+  return nReceived;
+#endif
+}
+
+size_t
+DatagramBatch::send(int fd, const std::deque<Block>& datagrams,
+                    const sockaddr* destination, socklen_t destinationLength,
+                    boost::system::error_code& error)
+{
+  size_t nDatagrams = std::min(datagrams.size(), MAX_BATCH_SIZE);
+
+#ifdef __linux__
+  iovec iovecs[MAX_BATCH_SIZE];
+  mmsghdr messages[MAX_BATCH_SIZE];
+  std::memset(messages, 0, sizeof(messages));
+  for (size_t i = 0; i < nDatagrams; ++i) {
+    iovecs[i].iov_base = const_cast<uint8_t*>(datagrams[i].wire());
+    iovecs[i].iov_len = datagrams[i].size();
+    messages[i].msg_hdr.msg_name = const_cast<sockaddr*>(destination);
+    messages[i].msg_hdr.msg_namelen = destination == nullptr ? 0 : destinationLength;
+    messages[i].msg_hdr.msg_iov = &iovecs[i];
+    messages[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  int nSent = ::sendmmsg(fd, messages, nDatagrams, MSG_DONTWAIT);
+  if (nSent < 0) {
+    if (isWouldBlock(errno))
+      error = boost::asio::error::would_block;
+    else
+      error.assign(errno, boost::system::system_category());
+    return 0;
+  }
+  return static_cast<size_t>(nSent);
+#else
+  size_t nSent = 0;
+  for (; nSent < nDatagrams; ++nSent) {
+    const Block& datagram = datagrams[nSent];
+    ssize_t size = ::sendto(fd, datagram.wire(), datagram.size(), MSG_DONTWAIT,
+                            destination, destination == nullptr ? 0 : destinationLength);
+    if (size < 0) {
+      if (isWouldBlock(errno))
+        error = boost::asio::error::would_block;
+      else
+        error.assign(errno, boost::system::system_category());
+      break;
+    }
+  }
+  return nSent;
+#endif
+}
+
+DatagramBatch&
+getGlobalDatagramBatch()
+{
+  static DatagramBatch batch;
+  return batch;
+}
+
+} // namespace nfd
@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_DATAGRAM_BATCH_HPP
+#define NFD_DAEMON_FACE_DATAGRAM_BATCH_HPP
+
+#include "common.hpp"
+
+#include <cstring>
+#include <deque>
+#include <sys/socket.h>
+
+#ifdef __linux__
+#include <sys/uio.h>
+#endif
+
+namespace nfd {
+
+/** \brief buffers to receive or send several datagrams in one system call
+ *
+ *  On Linux, datagrams are transferred with recvmmsg(2) and sendmmsg(2).
+ *  Elsewhere, they are transferred one at a time with non-blocking recvfrom(2) and sendto(2),
+ *  which still saves a trip through the event loop per datagram.
+ *
+ *  All sockets are served by the global io_service thread, and received datagrams are
+ *  processed before the next receive, so a single batch is shared by all datagram faces
+ *  and channels (see getGlobalDatagramBatch).
+ */
+class DatagramBatch : noncopyable
+{
+public:
+  /** \brief maximum number of datagrams transferred in one call
+   */
+  static const size_t MAX_BATCH_SIZE = 32;
+
+  DatagramBatch();
+
+  /** \brief receive up to MAX_BATCH_SIZE datagrams from a socket without blocking
+   *  \param fd a datagram socket
+   *  \param[out] error set on socket error; not set if no datagram is available
+   *  \return number of datagrams received
+   */
+  size_t
+  receive(int fd, boost::system::error_code& error);
+
+  /** \return wire of the i-th received datagram
+   */
+  const uint8_t*
+  getDatagram(size_t i) const
+  {
+    BOOST_ASSERT(i < MAX_BATCH_SIZE);
+    return m_storage.data() + i * ndn::MAX_NDN_PACKET_SIZE;
+  }
+
+  /** \return size of the i-th received datagram
+   */
+  size_t
+  getDatagramSize(size_t i) const
+  {
+    BOOST_ASSERT(i < MAX_BATCH_SIZE);
+    return m_sizes[i];
+  }
+
+  /** \return source endpoint of the i-th received datagram
+   *  \tparam Endpoint a Boost.Asio endpoint type, such as boost::asio::ip::udp::endpoint
+   */
+  template<typename Endpoint>
+  Endpoint
+  getSource(size_t i) const
+  {
+    BOOST_ASSERT(i < MAX_BATCH_SIZE);
+    Endpoint endpoint;
+    size_t length = std::min<size_t>(m_sourceLengths[i], endpoint.capacity());
+    std::memcpy(endpoint.data(), &m_sources[i], length);
+    endpoint.resize(length);
+    return endpoint;
+  }
+
+  /** \brief send datagrams from the front of a queue without blocking
+   *  \param fd a datagram socket
+   *  \param datagrams queue of datagrams; at most MAX_BATCH_SIZE are sent
+   *  \param destination destination address, or nullptr if the socket is connected
+   *  \param destinationLength length of destination address
+   *  \param[out] error set on socket error, or to boost::asio::error::would_block
+   *                    if the socket cannot accept more datagrams
+   *  \return number of datagrams sent from the front of the queue
+   */
+  static size_t
+  send(int fd, const std::deque<Block>& datagrams,
+       const sockaddr* destination, socklen_t destinationLength,
+       boost::system::error_code& error);
+
+private:
+  std::vector<uint8_t> m_storage;
+  size_t m_sizes[MAX_BATCH_SIZE];
+  sockaddr_storage m_sources[MAX_BATCH_SIZE];
+  socklen_t m_sourceLengths[MAX_BATCH_SIZE];
+
+#ifdef __linux__
+  iovec m_iovecs[MAX_BATCH_SIZE];
+  mmsghdr m_messages[MAX_BATCH_SIZE];
+#endif
+};
+
+/** \return the DatagramBatch shared by all datagram faces and channels
+ */
+DatagramBatch&
+getGlobalDatagramBatch();
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_DATAGRAM_BATCH_HPP
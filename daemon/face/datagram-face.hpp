@@ -27,7 +27,12 @@
 #define NFD_DAEMON_FACE_DATAGRAM_FACE_HPP
 
 #include "face.hpp"
+#include "datagram-batch.hpp"
+#include "ndnlp-tlv.hpp"
 #include "core/global-io.hpp"
+#include "core/scheduler.hpp"
+
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
 
 namespace nfd {
 
@@ -47,6 +52,19 @@ public:
   DatagramFace(const FaceUri& remoteUri, const FaceUri& localUri,
                typename protocol::socket socket);
 
+  /** \brief Construct datagram face that shares a socket with other faces
+   *
+   *  The face does not receive from the socket; its owner must pass incoming
+   *  datagrams from \p remoteEndpoint to receiveDatagram. Outgoing datagrams are
+   *  sent to \p remoteEndpoint with send_to. Closing the face leaves the socket open.
+   *
+   * \param sharedSocket   Protocol-specific socket, which must outlive the face
+   * \param remoteEndpoint Endpoint of the remote peer
+   */
+  DatagramFace(const FaceUri& remoteUri, const FaceUri& localUri,
+               typename protocol::socket& sharedSocket,
+               const typename protocol::endpoint& remoteEndpoint);
+
   // from Face
   void
   sendInterest(const Interest& interest) DECL_OVERRIDE;
@@ -62,18 +80,65 @@ public:
                   size_t nBytesReceived,
                   const boost::system::error_code& error);
 
+  /** \brief enables aggregation of outgoing packets
+   *
+   *  Consecutive queued packets are sent together in one datagram:
+   *
+   *      NdnlpAggregate ::= NDNLP-AGGREGATE-TYPE TLV-LENGTH (Interest|Data)+
+   *
+   *  A packet waits at most \p flushDelay for more packets, unless enough packets
+   *  to fill a datagram are queued. Incoming aggregates are always accepted.
+   *
+   *  \param maxDatagramSize maximum size of an aggregate datagram
+   *  \param flushDelay maximum time a packet waits to be aggregated
+   */
+  void
+  enableAggregation(size_t maxDatagramSize, const time::microseconds& flushDelay);
+
+  /** \brief returns when a valid packet was last received on the face,
+   *         or when the face was created if none has been received
+   */
+  const time::steady_clock::TimePoint&
+  getLastUsedTime() const;
+
 protected:
   void
   processErrorCode(const boost::system::error_code& error);
 
+  /** \brief queue a datagram for sending
+   *
+   *  Datagrams queued while handling one event are sent together in a batch
+   *  after the event handler returns.
+   */
+  void
+  sendBlock(const Block& block);
+
+  /** \return socket used for sending
+   */
+  virtual typename protocol::socket&
+  getSendSocket();
+
+  /** \return destination of outgoing datagrams, or nullptr if the send socket is connected
+   */
+  virtual const typename protocol::endpoint*
+  getSendDestination() const;
+
+  void
+  flushSendQueue(const shared_ptr<Face>& face);
+
+  /** \brief replaces runs of small packets in the send queue with aggregates
+   */
+  void
+  aggregateSendQueue();
+
+  void
+  handleWritable(const boost::system::error_code& error, const shared_ptr<Face>& face);
+
   void
-  handleSend(const boost::system::error_code& error,
-             size_t nBytesSent,
-             const Block& payload);
+  handleReadable(const boost::system::error_code& error);
 
   void
-  handleReceive(const boost::system::error_code& error,
-                size_t nBytesReceived);
+  startReceive();
 
   void
   keepFaceAliveUntilAllHandlersExecuted(const shared_ptr<Face>& face);
@@ -81,14 +146,10 @@ protected:
   void
   closeSocket();
 
-  bool
-  hasBeenUsedRecently() const;
-
-  /**
-   * \brief Set m_hasBeenUsedRecently to false
+  /** \return whether the face can still send and receive
    */
-  void
-  resetRecentUsage();
+  bool
+  isOpen() const;
 
 protected:
   typename protocol::socket m_socket;
@@ -96,8 +157,23 @@ protected:
   NFD_LOG_INCLASS_DECLARE();
 
 private:
-  uint8_t m_inputBuffer[ndn::MAX_NDN_PACKET_SIZE];
-  bool m_hasBeenUsedRecently;
+  /// socket shared with other faces, nullptr if m_socket is used
+  typename protocol::socket* m_sharedSocket;
+  typename protocol::endpoint m_remoteEndpoint;
+  bool m_isSharedSocketClosed;
+
+  time::steady_clock::TimePoint m_lastUsedTime;
+
+  std::deque<Block> m_sendQueue;
+  size_t m_sendQueueBytes;
+  bool m_isFlushScheduled;
+  bool m_isWaitingWritable;
+
+  /// maximum size of an aggregate, zero if aggregation is disabled
+  size_t m_maxAggregateSize;
+  time::microseconds m_aggregationDelay;
+  scheduler::ScopedEventId m_aggregationTimer;
+  bool m_isAggregationTimerScheduled;
 };
 
 
@@ -107,13 +183,38 @@ DatagramFace<T, U>::DatagramFace(const FaceUri& remoteUri, const FaceUri& localU
                                  typename DatagramFace::protocol::socket socket)
   : Face(remoteUri, localUri, false, std::is_same<U, Multicast>::value)
   , m_socket(std::move(socket))
+  , m_sharedSocket(nullptr)
+  , m_isSharedSocketClosed(false)
+  , m_lastUsedTime(time::steady_clock::now())
+  , m_sendQueueBytes(0)
+  , m_isFlushScheduled(false)
+  , m_isWaitingWritable(false)
+  , m_maxAggregateSize(0)
+  , m_isAggregationTimerScheduled(false)
 {
   NFD_LOG_FACE_INFO("Creating face");
 
-  m_socket.async_receive(boost::asio::buffer(m_inputBuffer, ndn::MAX_NDN_PACKET_SIZE),
-                         bind(&DatagramFace<T, U>::handleReceive, this,
-                              boost::asio::placeholders::error,
-                              boost::asio::placeholders::bytes_transferred));
+  startReceive();
+}
+
+template<class T, class U>
+inline
+DatagramFace<T, U>::DatagramFace(const FaceUri& remoteUri, const FaceUri& localUri,
+                                 typename DatagramFace::protocol::socket& sharedSocket,
+                                 const typename DatagramFace::protocol::endpoint& remoteEndpoint)
+  : Face(remoteUri, localUri, false, std::is_same<U, Multicast>::value)
+  , m_socket(getGlobalIoService())
+  , m_sharedSocket(&sharedSocket)
+  , m_remoteEndpoint(remoteEndpoint)
+  , m_isSharedSocketClosed(false)
+  , m_lastUsedTime(time::steady_clock::now())
+  , m_sendQueueBytes(0)
+  , m_isFlushScheduled(false)
+  , m_isWaitingWritable(false)
+  , m_maxAggregateSize(0)
+  , m_isAggregationTimerScheduled(false)
+{
+  NFD_LOG_FACE_INFO("Creating face on shared socket");
 }
 
 template<class T, class U>
@@ -124,12 +225,7 @@ DatagramFace<T, U>::sendInterest(const Interest& interest)
 
   this->emitSignal(onSendInterest, interest);
 
-  const Block& payload = interest.wireEncode();
-  m_socket.async_send(boost::asio::buffer(payload.wire(), payload.size()),
-                      bind(&DatagramFace<T, U>::handleSend, this,
-                           boost::asio::placeholders::error,
-                           boost::asio::placeholders::bytes_transferred,
-                           payload));
+  sendBlock(interest.wireEncode());
 }
 
 template<class T, class U>
@@ -140,19 +236,14 @@ DatagramFace<T, U>::sendData(const Data& data)
 
   this->emitSignal(onSendData, data);
 
-  const Block& payload = data.wireEncode();
-  m_socket.async_send(boost::asio::buffer(payload.wire(), payload.size()),
-                      bind(&DatagramFace<T, U>::handleSend, this,
-                           boost::asio::placeholders::error,
-                           boost::asio::placeholders::bytes_transferred,
-                           payload));
+  sendBlock(data.wireEncode());
 }
 
 template<class T, class U>
 inline void
 DatagramFace<T, U>::close()
 {
-  if (!m_socket.is_open())
+  if (!isOpen())
     return;
 
   NFD_LOG_FACE_INFO("Closing face");
@@ -173,7 +264,7 @@ DatagramFace<T, U>::processErrorCode(const boost::system::error_code& error)
     return;
   }
 
-  if (!m_socket.is_open()) {
+  if (!isOpen()) {
     this->fail("Tunnel closed");
     return;
   }
@@ -191,30 +282,208 @@ DatagramFace<T, U>::processErrorCode(const boost::system::error_code& error)
 
 template<class T, class U>
 inline void
-DatagramFace<T, U>::handleSend(const boost::system::error_code& error,
-                               size_t nBytesSent,
-                               const Block& payload)
-// 'payload' is unused; it's needed to retain the underlying Buffer
+DatagramFace<T, U>::enableAggregation(size_t maxDatagramSize,
+                                      const time::microseconds& flushDelay)
 {
-  if (error)
-    return processErrorCode(error);
+  m_maxAggregateSize = maxDatagramSize;
+  m_aggregationDelay = flushDelay;
+}
+
+template<class T, class U>
+inline void
+DatagramFace<T, U>::sendBlock(const Block& block)
+{
+  m_sendQueue.push_back(block);
+  m_sendQueueBytes += block.size();
+
+  if (m_isFlushScheduled || m_isWaitingWritable)
+    return;
+
+  if (m_maxAggregateSize > 0 && m_sendQueueBytes < m_maxAggregateSize) {
+    // wait for more packets to aggregate with
+    if (!m_isAggregationTimerScheduled) {
+      m_isAggregationTimerScheduled = true;
+      m_aggregationTimer = scheduler::schedule(m_aggregationDelay,
+                                               bind(&DatagramFace<T, U>::flushSendQueue,
+                                                    this, this->shared_from_this()));
+    }
+    return;
+  }
+
+  m_isFlushScheduled = true;
+  scheduler::schedule(time::nanoseconds::zero(),
+                      bind(&DatagramFace<T, U>::flushSendQueue, this, this->shared_from_this()));
+}
+
+template<class T, class U>
+inline typename DatagramFace<T, U>::protocol::socket&
+DatagramFace<T, U>::getSendSocket()
+{
+  return m_sharedSocket != nullptr ? *m_sharedSocket : m_socket;
+}
+
+template<class T, class U>
+inline const typename DatagramFace<T, U>::protocol::endpoint*
+DatagramFace<T, U>::getSendDestination() const
+{
+  return m_sharedSocket != nullptr ? &m_remoteEndpoint : nullptr;
+}
+
+template<class T, class U>
+inline void
+DatagramFace<T, U>::flushSendQueue(const shared_ptr<Face>& face)
+// 'face' is unused; it's needed to keep the face alive until the queue is flushed
+{
+  m_isFlushScheduled = false;
+  if (m_isAggregationTimerScheduled) {
+    m_isAggregationTimerScheduled = false;
+    m_aggregationTimer.cancel();
+  }
+
+  if (m_maxAggregateSize > 0)
+    aggregateSendQueue();
+
+  const typename protocol::endpoint* destination = getSendDestination();
+  while (!m_sendQueue.empty() && isOpen()) {
+    boost::system::error_code error;
+    size_t nSent = DatagramBatch::send(getSendSocket().native_handle(), m_sendQueue,
+                                       destination == nullptr ? nullptr : destination->data(),
+                                       destination == nullptr ? 0 : destination->size(),
+                                       error);
+
+    size_t nBytesSent = 0;
+    for (size_t i = 0; i < nSent; ++i)
+      nBytesSent += m_sendQueue[i].size();
+    m_sendQueue.erase(m_sendQueue.begin(), m_sendQueue.begin() + nSent);
+    m_sendQueueBytes -= nBytesSent;
+
+    if (nSent > 0) {
+      NFD_LOG_FACE_TRACE("Successfully sent: " << nBytesSent << " bytes in " <<
+                         nSent << " datagrams");
+      this->getMutableCounters().getNOutBytes() += nBytesSent;
+    }
+
+    if (error == boost::asio::error::would_block) {
+      m_isWaitingWritable = true;
+      getSendSocket().async_send(boost::asio::null_buffers(),
+                                 bind(&DatagramFace<T, U>::handleWritable, this,
+                                      boost::asio::placeholders::error,
+                                      this->shared_from_this()));
+      return;
+    }
 
-  NFD_LOG_FACE_TRACE("Successfully sent: " << nBytesSent << " bytes");
-  this->getMutableCounters().getNOutBytes() += nBytesSent;
+    if (error) {
+      // drop the datagram that could not be sent
+      m_sendQueueBytes -= m_sendQueue.front().size();
+      m_sendQueue.pop_front();
+      processErrorCode(error);
+    }
+  }
+
+  if (!isOpen()) {
+    m_sendQueue.clear();
+    m_sendQueueBytes = 0;
+  }
 }
 
 template<class T, class U>
 inline void
-DatagramFace<T, U>::handleReceive(const boost::system::error_code& error,
-                                  size_t nBytesReceived)
+DatagramFace<T, U>::aggregateSendQueue()
 {
-  receiveDatagram(m_inputBuffer, nBytesReceived, error);
+  // type and length of NdnlpAggregate take at most 4 octets when it's smaller than 64KB
+  static const size_t AGGREGATE_OVERHEAD = 4;
+
+  std::deque<Block> queue;
+  m_sendQueueBytes = 0;
+
+  auto runBegin = m_sendQueue.begin();
+  while (runBegin != m_sendQueue.end()) {
+    // find a run of packets that fit in one aggregate; an existing aggregate,
+    // queued while waiting for the socket to become writable, is never nested
+    auto runEnd = runBegin;
+    size_t runBytes = 0;
+    while (runEnd != m_sendQueue.end() && runEnd->type() != tlv::NdnlpAggregate &&
+           AGGREGATE_OVERHEAD + runBytes + runEnd->size() <= m_maxAggregateSize) {
+      runBytes += runEnd->size();
+      ++runEnd;
+    }
+
+    if (std::distance(runBegin, runEnd) < 2) {
+      // a lone packet is sent as is
+      queue.push_back(*runBegin);
+      m_sendQueueBytes += runBegin->size();
+      ++runBegin;
+      continue;
+    }
+
+    ndn::EncodingBuffer encoder(AGGREGATE_OVERHEAD + runBytes, 0);
+    size_t length = 0;
+    for (auto it = runEnd; it != runBegin;) {
+      --it;
+      length += encoder.prependBlock(*it);
+    }
+    encoder.prependVarNumber(length);
+    encoder.prependVarNumber(tlv::NdnlpAggregate);
+
+    queue.push_back(encoder.block());
+    m_sendQueueBytes += queue.back().size();
+    this->getMutableCounters().getNOutBytesCopied() += runBytes;
+    runBegin = runEnd;
+  }
+
+  m_sendQueue.swap(queue);
+}
+
+template<class T, class U>
+inline void
+DatagramFace<T, U>::handleWritable(const boost::system::error_code& error,
+                                   const shared_ptr<Face>& face)
+// 'face' is unused; it keeps the face alive while it waits on a shared socket,
+// which is not closed together with the face
+{
+  m_isWaitingWritable = false;
+
+  if (error) {
+    processErrorCode(error);
+    if (!isOpen()) {
+      m_sendQueue.clear();
+      return;
+    }
+  }
+
+  flushSendQueue(face);
+}
+
+template<class T, class U>
+inline void
+DatagramFace<T, U>::startReceive()
+{
+  m_socket.async_receive(boost::asio::null_buffers(),
+                         bind(&DatagramFace<T, U>::handleReadable, this,
+                              boost::asio::placeholders::error));
+}
+
+template<class T, class U>
+inline void
+DatagramFace<T, U>::handleReadable(const boost::system::error_code& error)
+{
+  if (error) {
+    processErrorCode(error);
+  }
+  else {
+    DatagramBatch& batch = getGlobalDatagramBatch();
+    boost::system::error_code receiveError;
+    size_t nReceived = batch.receive(m_socket.native_handle(), receiveError);
+
+    for (size_t i = 0; i < nReceived && m_socket.is_open(); ++i)
+      receiveDatagram(batch.getDatagram(i), batch.getDatagramSize(i), receiveError);
+
+    if (receiveError)
+      processErrorCode(receiveError);
+  }
 
   if (m_socket.is_open())
-    m_socket.async_receive(boost::asio::buffer(m_inputBuffer, ndn::MAX_NDN_PACKET_SIZE),
-                           bind(&DatagramFace<T, U>::handleReceive, this,
-                                boost::asio::placeholders::error,
-                                boost::asio::placeholders::bytes_transferred));
+    startReceive();
 }
 
 template<class T, class U>
@@ -246,6 +515,30 @@ DatagramFace<T, U>::receiveDatagram(const uint8_t* buffer,
       return;
     }
 
+  if (element.type() == tlv::NdnlpAggregate)
+    {
+      try {
+        element.parse();
+      }
+      catch (const tlv::Error&) {
+        NFD_LOG_FACE_WARN("Failed to parse incoming aggregate");
+        // This message won't extend the face lifetime
+        return;
+      }
+
+      bool isOk = false;
+      for (const Block& packet : element.elements()) {
+        if (this->decodeAndDispatchInput(packet))
+          isOk = true;
+        else
+          NFD_LOG_FACE_WARN("Received unrecognized TLV block of type " << packet.type());
+      }
+
+      if (isOk)
+        m_lastUsedTime = time::steady_clock::now();
+      return;
+    }
+
   if (!this->decodeAndDispatchInput(element))
     {
       NFD_LOG_FACE_WARN("Received unrecognized TLV block of type " << element.type());
@@ -253,7 +546,7 @@ DatagramFace<T, U>::receiveDatagram(const uint8_t* buffer,
       return;
     }
 
-  m_hasBeenUsedRecently = true;
+  m_lastUsedTime = time::steady_clock::now();
 }
 
 template<class T, class U>
@@ -269,6 +562,11 @@ DatagramFace<T, U>::closeSocket()
 {
   NFD_LOG_FACE_TRACE(__func__);
 
+  if (m_sharedSocket != nullptr) {
+    // the socket belongs to the owner of the face and stays open
+    m_isSharedSocketClosed = true;
+  }
+
   // use the non-throwing variants and ignore errors, if any
   boost::system::error_code error;
   m_socket.shutdown(protocol::socket::shutdown_both, error);
@@ -283,16 +581,19 @@ DatagramFace<T, U>::closeSocket()
 
 template<class T, class U>
 inline bool
-DatagramFace<T, U>::hasBeenUsedRecently() const
+DatagramFace<T, U>::isOpen() const
 {
-  return m_hasBeenUsedRecently;
+  if (m_sharedSocket != nullptr)
+    return !m_isSharedSocketClosed && m_sharedSocket->is_open();
+
+  return m_socket.is_open();
 }
 
 template<class T, class U>
-inline void
-DatagramFace<T, U>::resetRecentUsage()
+inline const time::steady_clock::TimePoint&
+DatagramFace<T, U>::getLastUsedTime() const
 {
-  m_hasBeenUsedRecently = false;
+  return m_lastUsedTime;
 }
 
 } // namespace nfd
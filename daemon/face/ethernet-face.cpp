@@ -25,6 +25,7 @@
 
 #include "ethernet-face.hpp"
 #include "core/global-io.hpp"
+#include "core/scheduler.hpp"
 
 #include <pcap/pcap.h>
 
@@ -61,12 +62,16 @@ namespace nfd {
 NFD_LOG_INIT("EthernetFace");
 
 const time::nanoseconds EthernetFace::REASSEMBLER_LIFETIME = time::seconds(60);
+const size_t EthernetFace::REASSEMBLY_MEMORY_LIMIT = 4 * 1024 * 1024;
 
 EthernetFace::EthernetFace(boost::asio::posix::stream_descriptor socket,
                            const NetworkInterfaceInfo& interface,
                            const ethernet::Address& address)
   : Face(FaceUri(address), FaceUri::fromDev(interface.name), false, true)
   , m_pcap(nullptr, pcap_close)
+#ifdef HAVE_TPACKET_V3
+  , m_isRingFlushScheduled(false)
+#endif
   , m_socket(std::move(socket))
 #if defined(__linux__)
   , m_interfaceIndex(interface.index)
@@ -74,41 +79,65 @@ EthernetFace::EthernetFace(boost::asio::posix::stream_descriptor socket,
   , m_interfaceName(interface.name)
   , m_srcAddress(interface.etherAddress)
   , m_destAddress(address)
+  , m_reassemblyMemory(make_shared<ndnlp::ReassemblyMemory>(REASSEMBLY_MEMORY_LIMIT))
 #ifdef _DEBUG
   , m_nDropped(0)
 #endif
 {
   NFD_LOG_FACE_INFO("Creating face on " << m_interfaceName << "/" << m_srcAddress);
-  pcapInit();
 
-  int fd = pcap_get_selectable_fd(m_pcap.get());
-  if (fd < 0)
-    BOOST_THROW_EXCEPTION(Error("pcap_get_selectable_fd failed"));
+#ifdef HAVE_TPACKET_V3
+  if (!ringInit())
+#endif
+    {
+      pcapInit();
+
+      int fd = pcap_get_selectable_fd(m_pcap.get());
+      if (fd < 0)
+        BOOST_THROW_EXCEPTION(Error("pcap_get_selectable_fd failed"));
 
-  // need to duplicate the fd, otherwise both pcap_close()
-  // and stream_descriptor::close() will try to close the
-  // same fd and one of them will fail
-  m_socket.assign(::dup(fd));
+      // need to duplicate the fd, otherwise both pcap_close()
+      // and stream_descriptor::close() will try to close the
+      // same fd and one of them will fail
+      m_socket.assign(::dup(fd));
+    }
 
   m_interfaceMtu = getInterfaceMtu();
   NFD_LOG_FACE_DEBUG("Interface MTU is: " << m_interfaceMtu);
 
   m_slicer.reset(new ndnlp::Slicer(m_interfaceMtu));
 
-  char filter[100];
-  // std::snprintf not found in some environments
-  // http://redmine.named-data.net/issues/2299 for more information
-  snprintf(filter, sizeof(filter),
-           "(ether proto 0x%x) && (ether dst %s) && (not ether src %s)",
-           ethernet::ETHERTYPE_NDN,
-           m_destAddress.toString().c_str(),
-           m_srcAddress.toString().c_str());
-  setPacketFilter(filter);
+  if (m_pcap)
+    {
+      char filter[100];
+      // std::snprintf not found in some environments
+      // http://redmine.named-data.net/issues/2299 for more information
+      snprintf(filter, sizeof(filter),
+               "(ether proto 0x%x) && (ether dst %s) && (not ether src %s)",
+               ethernet::ETHERTYPE_NDN,
+               m_destAddress.toString().c_str(),
+               m_srcAddress.toString().c_str());
+      setPacketFilter(filter);
+    }
+  // else: the packet ring captures only the NDN ethertype, and
+  //       addresses are filtered in handleRead
 
   if (!m_destAddress.isBroadcast() && !joinMulticastGroup())
     {
       NFD_LOG_FACE_WARN("Falling back to promiscuous mode");
-      pcap_set_promisc(m_pcap.get(), 1);
+      if (m_pcap)
+        pcap_set_promisc(m_pcap.get(), 1);
+#ifdef HAVE_TPACKET_V3
+      else
+        {
+          packet_mreq mr{};
+          mr.mr_ifindex = m_interfaceIndex;
+          mr.mr_type = PACKET_MR_PROMISC;
+          if (::setsockopt(m_socket.native_handle(), SOL_PACKET,
+                           PACKET_ADD_MEMBERSHIP, &mr, sizeof(mr)) < 0)
+            NFD_LOG_FACE_WARN("setsockopt(PACKET_MR_PROMISC) failed: " << std::strerror(errno));
+        }
+#endif
     }
 
   m_socket.async_read_some(boost::asio::null_buffers(),
@@ -124,9 +153,10 @@ EthernetFace::sendInterest(const Interest& interest)
 
   this->emitSignal(onSendInterest, interest);
 
-  ndnlp::PacketArray pa = m_slicer->slice(interest.wireEncode());
-  for (const auto& packet : *pa) {
-    sendPacket(packet);
+  const Block& payload = interest.wireEncode();
+  const ndnlp::FragmentArray& fragments = m_slicer->sliceInPlace(payload);
+  for (const auto& fragment : fragments) {
+    sendPacket(fragment);
   }
 }
 
@@ -137,16 +167,17 @@ EthernetFace::sendData(const Data& data)
 
   this->emitSignal(onSendData, data);
 
-  ndnlp::PacketArray pa = m_slicer->slice(data.wireEncode());
-  for (const auto& packet : *pa) {
-    sendPacket(packet);
+  const Block& payload = data.wireEncode();
+  const ndnlp::FragmentArray& fragments = m_slicer->sliceInPlace(payload);
+  for (const auto& fragment : fragments) {
+    sendPacket(fragment);
   }
 }
 
 void
 EthernetFace::close()
 {
-  if (!m_pcap)
+  if (!m_socket.is_open())
     return;
 
   NFD_LOG_FACE_INFO("Closing face");
@@ -155,10 +186,40 @@ EthernetFace::close()
   m_socket.cancel(error); // ignore errors
   m_socket.close(error);  // ignore errors
   m_pcap.reset();
+  // the packet ring is kept until destruction, because close()
+  // may be invoked while handleRead is iterating over the ring
 
   fail("Face closed");
 }
 
+#ifdef HAVE_TPACKET_V3
+bool
+EthernetFace::ringInit()
+{
+  try {
+    m_ring.reset(new EthernetPacketRing(m_interfaceIndex));
+  }
+  catch (const EthernetPacketRing::Error& e) {
+    NFD_LOG_FACE_DEBUG("Cannot use packet ring, falling back to libpcap: " << e.what());
+    return false;
+  }
+
+  // the ring owns its fd, see comment in the constructor
+  m_socket.assign(::dup(m_ring->getFd()));
+  return true;
+}
+
+void
+EthernetFace::flushRing(const shared_ptr<Face>& face)
+// 'face' is unused; it's needed to keep the face alive until the ring is flushed
+{
+  m_isRingFlushScheduled = false;
+
+  if (m_socket.is_open())
+    m_ring->flush();
+}
+#endif // HAVE_TPACKET_V3
+
 void
 EthernetFace::pcapInit()
 {
@@ -266,57 +327,126 @@ EthernetFace::joinMulticastGroup()
 }
 
 void
-EthernetFace::sendPacket(const ndn::Block& block)
+EthernetFace::writeEthernetHeader(uint8_t* buf) const
 {
-  if (!m_pcap)
+  static const uint16_t ethertype = htons(ethernet::ETHERTYPE_NDN);
+  std::copy(m_destAddress.begin(), m_destAddress.end(), buf);
+  std::copy(m_srcAddress.begin(), m_srcAddress.end(), buf + ethernet::ADDR_LEN);
+  std::memcpy(buf + 2 * ethernet::ADDR_LEN, &ethertype, ethernet::TYPE_LEN);
+}
+
+void
+EthernetFace::sendPacket(const ndnlp::Fragment& fragment)
+{
+  if (!m_socket.is_open())
     {
       NFD_LOG_FACE_WARN("Trying to send on closed face");
       return fail("Face closed");
     }
 
-  BOOST_ASSERT(block.size() <= m_interfaceMtu);
+  BOOST_ASSERT(fragment.size() <= m_interfaceMtu);
 
-  /// \todo Right now there is no reserve when packet is received, but
-  ///       we should reserve some space at the beginning and at the end
-  ndn::EncodingBuffer buffer(block);
-
-  // pad with zeroes if the payload is too short
-  if (block.size() < ethernet::MIN_DATA_LEN)
+#ifdef HAVE_TPACKET_V3
+  if (m_ring)
     {
-      static const uint8_t padding[ethernet::MIN_DATA_LEN] = {};
-      buffer.appendByteArray(padding, ethernet::MIN_DATA_LEN - block.size());
+      uint8_t header[ethernet::HDR_LEN + ndnlp::Slicer::MAX_HEADER_SIZE];
+      writeEthernetHeader(header);
+      std::copy(fragment.header, fragment.header + fragment.headerSize,
+                header + ethernet::HDR_LEN);
+
+      // headers and payload are written directly into the transmit ring
+      if (!m_ring->send(header, ethernet::HDR_LEN + fragment.headerSize,
+                        fragment.payload, fragment.payloadSize,
+                        ethernet::HDR_LEN + ethernet::MIN_DATA_LEN))
+        {
+          NFD_LOG_FACE_WARN("Failed to queue frame, dropping it");
+          return;
+        }
+
+      // frames queued while handling one event are handed to the kernel together
+      if (m_ring->hasPendingFrames() && !m_isRingFlushScheduled)
+        {
+          m_isRingFlushScheduled = true;
+          scheduler::schedule(time::nanoseconds::zero(),
+                              bind(&EthernetFace::flushRing, this, shared_from_this()));
+        }
+
+      NFD_LOG_FACE_TRACE("Successfully queued: " << fragment.size() << " bytes");
+      this->getMutableCounters().getNOutBytes() += fragment.size();
+      return;
     }
+#endif
 
-  // construct and prepend the ethernet header
-  static uint16_t ethertype = htons(ethernet::ETHERTYPE_NDN);
-  buffer.prependByteArray(reinterpret_cast<const uint8_t*>(&ethertype), ethernet::TYPE_LEN);
-  buffer.prependByteArray(m_srcAddress.data(), m_srcAddress.size());
-  buffer.prependByteArray(m_destAddress.data(), m_destAddress.size());
+  // pcap_inject needs a contiguous frame, so the payload is copied once
+  size_t frameSize = ethernet::HDR_LEN + std::max(fragment.size(), ethernet::MIN_DATA_LEN);
+  m_frameBuffer.resize(frameSize);
+  uint8_t* pos = m_frameBuffer.data();
+  writeEthernetHeader(pos);
+  pos = std::copy(fragment.header, fragment.header + fragment.headerSize,
+                  pos + ethernet::HDR_LEN);
+  pos = std::copy(fragment.payload, fragment.payload + fragment.payloadSize, pos);
+  // pad with zeroes if the payload is too short
+  std::fill(pos, m_frameBuffer.data() + frameSize, 0);
+  this->getMutableCounters().getNOutBytesCopied() += fragment.payloadSize;
 
   // send the packet
-  int sent = pcap_inject(m_pcap.get(), buffer.buf(), buffer.size());
+  int sent = pcap_inject(m_pcap.get(), m_frameBuffer.data(), frameSize);
   if (sent < 0)
     {
       return fail("pcap_inject: " + std::string(pcap_geterr(m_pcap.get())));
     }
-  else if (static_cast<size_t>(sent) < buffer.size())
+  else if (static_cast<size_t>(sent) < frameSize)
     {
       return fail("Failed to inject frame");
     }
 
-  NFD_LOG_FACE_TRACE("Successfully sent: " << block.size() << " bytes");
-  this->getMutableCounters().getNOutBytes() += block.size();
+  NFD_LOG_FACE_TRACE("Successfully sent: " << fragment.size() << " bytes");
+  this->getMutableCounters().getNOutBytes() += fragment.size();
+}
+
+bool
+EthernetFace::isRingFrameWanted(const uint8_t* frame, size_t length, bool isOutgoing,
+                                const ethernet::Address& destAddress,
+                                const ethernet::Address& srcAddress)
+{
+  if (isOutgoing || length < ethernet::HDR_LEN)
+    return false;
+
+  const ether_header* eh = reinterpret_cast<const ether_header*>(frame);
+  return ethernet::Address(eh->ether_dhost) == destAddress &&
+         ethernet::Address(eh->ether_shost) != srcAddress &&
+         ntohs(eh->ether_type) == ethernet::ETHERTYPE_NDN;
 }
 
 void
 EthernetFace::handleRead(const boost::system::error_code& error, size_t)
 {
-  if (!m_pcap)
+  if (!m_socket.is_open())
     return fail("Face closed");
 
   if (error)
     return processErrorCode(error);
 
+#ifdef HAVE_TPACKET_V3
+  if (m_ring)
+    {
+      // process all frames in the ready blocks; the BPF filter used with libpcap
+      // is replaced by the checks below
+      m_ring->receive([this] (const uint8_t* frame, size_t length, bool isOutgoing) {
+          if (m_socket.is_open() &&
+              isRingFrameWanted(frame, length, isOutgoing, m_destAddress, m_srcAddress))
+            processIncomingFrame(frame, length);
+        });
+
+      if (m_socket.is_open())
+        m_socket.async_read_some(boost::asio::null_buffers(),
+                                 bind(&EthernetFace::handleRead, this,
+                                      boost::asio::placeholders::error,
+                                      boost::asio::placeholders::bytes_transferred));
+      return;
+    }
+#endif
+
   pcap_pkthdr* header;
   const uint8_t* packet;
   int ret = pcap_next_ex(m_pcap.get(), &header, &packet);
@@ -357,7 +487,12 @@ EthernetFace::handleRead(const boost::system::error_code& error, size_t)
 void
 EthernetFace::processIncomingPacket(const pcap_pkthdr* header, const uint8_t* packet)
 {
-  size_t length = header->caplen;
+  processIncomingFrame(packet, header->caplen);
+}
+
+void
+EthernetFace::processIncomingFrame(const uint8_t* packet, size_t length)
+{
   if (length < ethernet::HDR_LEN + ethernet::MIN_DATA_LEN) {
     NFD_LOG_FACE_WARN("Received frame is too short (" << length << " bytes)");
     return;
@@ -394,7 +529,12 @@ EthernetFace::processIncomingPacket(const pcap_pkthdr* header, const uint8_t* pa
   Reassembler& reassembler = m_reassemblers[sourceAddress];
   if (!reassembler.pms) {
     // new sender, setup a PartialMessageStore for it
-    reassembler.pms.reset(new ndnlp::PartialMessageStore);
+    reassembler.pms.reset(new ndnlp::PartialMessageStore(time::milliseconds(100),
+                                                         ndnlp::PartialMessageStore::DEFAULT_MAX_BYTES,
+                                                         m_reassemblyMemory));
+    reassembler.pms->onDrop.connect([this] {
+        ++this->getMutableCounters().getNReassemblyDrops();
+      });
     reassembler.pms->onReceive.connect(
       [this, sourceAddress] (const Block& block) {
         NFD_LOG_FACE_TRACE("All fragments received from " << sourceAddress.toString());
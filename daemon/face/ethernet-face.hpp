@@ -38,6 +38,10 @@
 #error "Cannot include this file when libpcap is not available"
 #endif
 
+#ifdef HAVE_TPACKET_V3
+#include "ethernet-packet-ring.hpp"
+#endif
+
 // forward declarations
 struct pcap;
 typedef pcap pcap_t;
@@ -81,6 +85,40 @@ public:
   close() DECL_OVERRIDE;
 
 private:
+#ifdef HAVE_TPACKET_V3
+  /**
+   * @brief Opens a TPACKET_V3 packet ring for capture and injection
+   *
+   * @return true if successful, false if libpcap should be used instead
+   */
+  bool
+  ringInit();
+
+  /**
+   * @brief Hands frames queued in the packet ring to the kernel
+   */
+  void
+  flushRing(const shared_ptr<Face>& face);
+#endif
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /**
+   * @brief Checks whether a frame captured by the packet ring is addressed to this face
+   *
+   * This replaces the BPF filter used with libpcap.
+   *
+   * @param frame pointer to the frame, including the link-layer header
+   * @param length length of the frame
+   * @param isOutgoing whether the frame was sent by this host
+   * @param destAddress multicast group of the face
+   * @param srcAddress address of the local interface
+   */
+  static bool
+  isRingFrameWanted(const uint8_t* frame, size_t length, bool isOutgoing,
+                    const ethernet::Address& destAddress, const ethernet::Address& srcAddress);
+
+private:
+
   /**
    * @brief Allocates and initializes a libpcap context for live capture
    */
@@ -104,10 +142,18 @@ private:
   joinMulticastGroup();
 
   /**
-   * @brief Sends the specified TLV block on the network wrapped in an Ethernet frame
+   * @brief Writes the Ethernet header of outgoing frames
+   *
+   * @param buf output buffer of at least ethernet::HDR_LEN octets
+   */
+  void
+  writeEthernetHeader(uint8_t* buf) const;
+
+  /**
+   * @brief Sends the specified NDNLP fragment on the network wrapped in an Ethernet frame
    */
   void
-  sendPacket(const ndn::Block& block);
+  sendPacket(const ndnlp::Fragment& fragment);
 
   /**
    * @brief Receive callback
@@ -126,6 +172,15 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   processIncomingPacket(const pcap_pkthdr* header, const uint8_t* packet);
 
 private:
+  /**
+   * @brief Processes an incoming frame
+   *
+   * @param packet pointer to the received frame, including the link-layer header
+   * @param length length of the frame
+   */
+  void
+  processIncomingFrame(const uint8_t* packet, size_t length);
+
   /**
    * @brief Handles errors encountered by Boost.Asio on the receive path
    */
@@ -146,6 +201,11 @@ private:
   };
 
   unique_ptr<pcap_t, void(*)(pcap_t*)> m_pcap;
+#ifdef HAVE_TPACKET_V3
+  /// packet ring, used instead of libpcap when available
+  unique_ptr<EthernetPacketRing> m_ring;
+  bool m_isRingFlushScheduled;
+#endif
   boost::asio::posix::stream_descriptor m_socket;
 
 #if defined(__linux__)
@@ -157,8 +217,13 @@ private:
 
   size_t m_interfaceMtu;
   unique_ptr<ndnlp::Slicer> m_slicer;
+  /// outgoing frame assembled for libpcap
+  std::vector<uint8_t> m_frameBuffer;
   std::unordered_map<ethernet::Address, Reassembler> m_reassemblers;
+  /// limits memory held by partial messages from all senders
+  shared_ptr<ndnlp::ReassemblyMemory> m_reassemblyMemory;
   static const time::nanoseconds REASSEMBLER_LIFETIME;
+  static const size_t REASSEMBLY_MEMORY_LIMIT;
 
 #ifdef _DEBUG
   /// number of packets dropped by the kernel, as reported by libpcap
@@ -0,0 +1,306 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ethernet-packet-ring.hpp"
+#include "core/logger.hpp"
+
+#include <ndn-cxx/util/ethernet.hpp>
+
+#include <cerrno>             // for errno
+#include <cstring>            // for std::strerror(), std::memcpy() and std::memset()
+#include <arpa/inet.h>        // for htons()
+#include <linux/if_packet.h>  // for TPACKET_V3 and struct tpacket_req3
+#include <net/if.h>
+#include <sys/ioctl.h>        // for ioctl()
+#include <sys/mman.h>         // for mmap() and munmap()
+#include <sys/socket.h>
+#include <sys/uio.h>          // for struct iovec
+#include <unistd.h>           // for close()
+
+namespace nfd {
+
+NFD_LOG_INIT("EthernetPacketRing");
+
+namespace ethernet = ndn::util::ethernet;
+
+/// size of a receive block; a block holds many frames
+static const size_t RX_BLOCK_SIZE = 1 << 18;
+/// number of receive blocks
+static const size_t RX_N_BLOCKS = 16;
+/// maximum time a partially filled receive block is held by the kernel, in milliseconds
+static const unsigned int RX_BLOCK_TIMEOUT = 2;
+
+/// minimum size of a transmit block; a block holds many transmit slots
+static const size_t TX_BLOCK_SIZE = 1 << 18;
+/// number of transmit blocks
+static const size_t TX_N_BLOCKS = 4;
+
+static std::string
+errnoString(const std::string& what)
+{
+  return what + ": " + std::strerror(errno);
+}
+
+/** \return MTU of the interface, or ethernet::MAX_DATA_LEN if it cannot be determined
+ */
+static size_t
+getInterfaceMtu(int fd, int interfaceIndex)
+{
+  ifreq ifr{};
+  if (::if_indextoname(interfaceIndex, ifr.ifr_name) != nullptr &&
+      ::ioctl(fd, SIOCGIFMTU, &ifr) == 0)
+    return static_cast<size_t>(ifr.ifr_mtu);
+
+  NFD_LOG_WARN(errnoString("Failed to get interface MTU"));
+  return ethernet::MAX_DATA_LEN;
+}
+
+/** \return size of a transmit slot that holds a frame of the given MTU
+ *
+ *  Slots are a power of two, so that they tile a transmit block with no gap.
+ */
+static size_t
+getTxFrameSize(size_t mtu)
+{
+  size_t needed = TPACKET3_HDRLEN - sizeof(sockaddr_ll) + ethernet::HDR_LEN + mtu;
+  size_t frameSize = TPACKET_ALIGNMENT;
+  while (frameSize < needed) {
+    frameSize <<= 1;
+  }
+  return frameSize;
+}
+
+EthernetPacketRing::EthernetPacketRing(int interfaceIndex)
+  : m_fd(-1)
+  , m_map(static_cast<uint8_t*>(MAP_FAILED))
+  , m_mapSize(0)
+  , m_rxRing(nullptr)
+  , m_rxBlockSize(RX_BLOCK_SIZE)
+  , m_rxNBlocks(RX_N_BLOCKS)
+  , m_rxBlockIndex(0)
+  , m_txRing(nullptr)
+  , m_txFrameSize(0)
+  , m_txNFrames(0)
+  , m_txFrameIndex(0)
+  , m_nPendingFrames(0)
+{
+  m_fd = ::socket(AF_PACKET, SOCK_RAW, htons(ethernet::ETHERTYPE_NDN));
+  if (m_fd < 0)
+    BOOST_THROW_EXCEPTION(Error(errnoString("socket(AF_PACKET)")));
+
+  try {
+    int version = TPACKET_V3;
+    if (::setsockopt(m_fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0)
+      BOOST_THROW_EXCEPTION(Error(errnoString("setsockopt(PACKET_VERSION)")));
+
+    tpacket_req3 rxReq{};
+    rxReq.tp_block_size = m_rxBlockSize;
+    rxReq.tp_block_nr = m_rxNBlocks;
+    rxReq.tp_frame_size = TPACKET_ALIGNMENT << 7;
+    rxReq.tp_frame_nr = (m_rxBlockSize * m_rxNBlocks) / rxReq.tp_frame_size;
+    rxReq.tp_retire_blk_tov = RX_BLOCK_TIMEOUT;
+    if (::setsockopt(m_fd, SOL_PACKET, PACKET_RX_RING, &rxReq, sizeof(rxReq)) < 0)
+      BOOST_THROW_EXCEPTION(Error(errnoString("setsockopt(PACKET_RX_RING)")));
+    m_mapSize = m_rxBlockSize * m_rxNBlocks;
+
+    // transmit slots are sized for the interface MTU, which may be a jumbo frame;
+    // transmit ring with TPACKET_V3 requires Linux 4.11 or later
+    m_txFrameSize = getTxFrameSize(getInterfaceMtu(m_fd, interfaceIndex));
+    tpacket_req3 txReq{};
+    txReq.tp_block_size = std::max(TX_BLOCK_SIZE, m_txFrameSize);
+    txReq.tp_block_nr = TX_N_BLOCKS;
+    txReq.tp_frame_size = m_txFrameSize;
+    txReq.tp_frame_nr = (txReq.tp_block_size * TX_N_BLOCKS) / m_txFrameSize;
+    bool hasTxRing = ::setsockopt(m_fd, SOL_PACKET, PACKET_TX_RING, &txReq, sizeof(txReq)) == 0;
+    if (hasTxRing) {
+      m_txNFrames = txReq.tp_frame_nr;
+      m_mapSize += txReq.tp_block_size * TX_N_BLOCKS;
+    }
+    else {
+      NFD_LOG_DEBUG(errnoString("setsockopt(PACKET_TX_RING)") << ", falling back to send()");
+    }
+
+    void* map = ::mmap(nullptr, m_mapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_LOCKED,
+                       m_fd, 0);
+    if (map == MAP_FAILED) {
+      // MAP_LOCKED may exceed RLIMIT_MEMLOCK
+      map = ::mmap(nullptr, m_mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    }
+    if (map == MAP_FAILED)
+      BOOST_THROW_EXCEPTION(Error(errnoString("mmap")));
+
+    m_map = static_cast<uint8_t*>(map);
+    m_rxRing = m_map;
+    if (hasTxRing)
+      m_txRing = m_map + m_rxBlockSize * m_rxNBlocks;
+
+    sockaddr_ll sll{};
+    sll.sll_family = AF_PACKET;
+    sll.sll_protocol = htons(ethernet::ETHERTYPE_NDN);
+    sll.sll_ifindex = interfaceIndex;
+    if (::bind(m_fd, reinterpret_cast<sockaddr*>(&sll), sizeof(sll)) < 0)
+      BOOST_THROW_EXCEPTION(Error(errnoString("bind(AF_PACKET)")));
+  }
+  catch (const Error&) {
+    if (m_map != MAP_FAILED)
+      ::munmap(m_map, m_mapSize);
+    ::close(m_fd);
+    throw;
+  }
+}
+
+EthernetPacketRing::~EthernetPacketRing()
+{
+  ::munmap(m_map, m_mapSize);
+  ::close(m_fd);
+}
+
+bool
+EthernetPacketRing::isBlockReady(const uint8_t* block)
+{
+  const tpacket_block_desc* desc = reinterpret_cast<const tpacket_block_desc*>(block);
+  bool isReady = (desc->hdr.bh1.block_status & TP_STATUS_USER) != 0;
+  // frames must not be read before the status
+  __sync_synchronize();
+  return isReady;
+}
+
+void
+EthernetPacketRing::releaseBlock(uint8_t* block)
+{
+  tpacket_block_desc* desc = reinterpret_cast<tpacket_block_desc*>(block);
+  __sync_synchronize();
+  desc->hdr.bh1.block_status = TP_STATUS_KERNEL;
+}
+
+size_t
+EthernetPacketRing::getFirstFrameOffset(const uint8_t* block)
+{
+  return reinterpret_cast<const tpacket_block_desc*>(block)->hdr.bh1.offset_to_first_pkt;
+}
+
+size_t
+EthernetPacketRing::getNFrames(const uint8_t* block)
+{
+  return reinterpret_cast<const tpacket_block_desc*>(block)->hdr.bh1.num_pkts;
+}
+
+std::tuple<const uint8_t*, size_t, bool, size_t>
+EthernetPacketRing::parseFrame(const uint8_t* block, size_t offset)
+{
+  const uint8_t* pos = block + offset;
+  const tpacket3_hdr* hdr = reinterpret_cast<const tpacket3_hdr*>(pos);
+  const sockaddr_ll* sll = reinterpret_cast<const sockaddr_ll*>(
+                             pos + TPACKET_ALIGN(sizeof(tpacket3_hdr)));
+  return std::make_tuple(pos + hdr->tp_mac, static_cast<size_t>(hdr->tp_snaplen),
+                         sll->sll_pkttype == PACKET_OUTGOING,
+                         static_cast<size_t>(hdr->tp_next_offset));
+}
+
+/** \brief writes header, payload and zero padding into a buffer
+ *  \return frame length
+ */
+static size_t
+writeFrame(uint8_t* buffer,
+           const uint8_t* header, size_t headerLength,
+           const uint8_t* payload, size_t payloadLength,
+           size_t minLength)
+{
+  size_t length = headerLength + payloadLength;
+  std::memcpy(buffer, header, headerLength);
+  if (payloadLength > 0)
+    std::memcpy(buffer + headerLength, payload, payloadLength);
+  if (length < minLength) {
+    std::memset(buffer + length, 0, minLength - length);
+    length = minLength;
+  }
+  return length;
+}
+
+bool
+EthernetPacketRing::send(const uint8_t* header, size_t headerLength,
+                         const uint8_t* payload, size_t payloadLength,
+                         size_t minLength)
+{
+  size_t frameLength = std::max(headerLength + payloadLength, minLength);
+
+  if (m_txRing == nullptr) {
+    // gather header, payload and padding, so that any frame the interface accepts can be sent
+    static const uint8_t padding[ethernet::HDR_LEN + ethernet::MIN_DATA_LEN] = {};
+    size_t paddingLength = frameLength - headerLength - payloadLength;
+    if (paddingLength > sizeof(padding))
+      return false;
+
+    iovec iov[3] = {
+      {const_cast<uint8_t*>(header), headerLength},
+      {const_cast<uint8_t*>(payload), payloadLength},
+      {const_cast<uint8_t*>(padding), paddingLength},
+    };
+    msghdr msg{};
+    msg.msg_iov = iov;
+    msg.msg_iovlen = 3;
+    return ::sendmsg(m_fd, &msg, 0) == static_cast<ssize_t>(frameLength);
+  }
+
+  const size_t dataOffset = TPACKET3_HDRLEN - sizeof(sockaddr_ll);
+  if (dataOffset + frameLength > m_txFrameSize)
+    return false;
+
+  uint8_t* slot = m_txRing + m_txFrameIndex * m_txFrameSize;
+  tpacket3_hdr* hdr = reinterpret_cast<tpacket3_hdr*>(slot);
+  if (hdr->tp_status != TP_STATUS_AVAILABLE) {
+    // ring is full: let the kernel drain it and try again once
+    flush();
+    if (hdr->tp_status != TP_STATUS_AVAILABLE)
+      return false;
+  }
+
+  writeFrame(slot + dataOffset, header, headerLength, payload, payloadLength, minLength);
+  hdr->tp_len = frameLength;
+  hdr->tp_snaplen = frameLength;
+  hdr->tp_next_offset = 0;
+  __sync_synchronize();
+  hdr->tp_status = TP_STATUS_SEND_REQUEST;
+
+  m_txFrameIndex = (m_txFrameIndex + 1) % m_txNFrames;
+  ++m_nPendingFrames;
+  return true;
+}
+
+bool
+EthernetPacketRing::flush()
+{
+  if (m_nPendingFrames == 0)
+    return true;
+
+  m_nPendingFrames = 0;
+  if (::send(m_fd, nullptr, 0, MSG_DONTWAIT) < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+    NFD_LOG_WARN(errnoString("send(PACKET_TX_RING)"));
+    return false;
+  }
+  return true;
+}
+
+} // namespace nfd
@@ -0,0 +1,201 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_ETHERNET_PACKET_RING_HPP
+#define NFD_DAEMON_FACE_ETHERNET_PACKET_RING_HPP
+
+#include "common.hpp"
+
+#ifndef HAVE_TPACKET_V3
+#error "Cannot include this file when TPACKET_V3 is not available"
+#endif
+
+namespace nfd {
+
+/**
+ * @brief AF_PACKET socket with memory-mapped TPACKET_V3 receive and transmit rings
+ *
+ * The kernel fills the receive ring in blocks of many frames; a block is handed
+ * to userspace when it is full or when its retire timeout expires, so one wakeup
+ * delivers a batch of frames that are read in place from the ring.
+ * Outgoing frames are written into transmit ring slots, which are sized for the
+ * interface MTU, and handed to the kernel together by flush().
+ *
+ * Only frames with the NDN ethertype are captured.
+ */
+class EthernetPacketRing : noncopyable
+{
+public:
+  struct Error : public std::runtime_error
+  {
+    Error(const std::string& what) : std::runtime_error(what) {}
+  };
+
+  /**
+   * @brief Opens an AF_PACKET socket bound to an interface and maps its rings
+   *
+   * If the kernel does not support a TPACKET_V3 transmit ring, frames are sent
+   * with send(2) instead.
+   *
+   * @throw Error the socket or the receive ring cannot be set up
+   */
+  explicit
+  EthernetPacketRing(int interfaceIndex);
+
+  ~EthernetPacketRing();
+
+  int
+  getFd() const
+  {
+    return m_fd;
+  }
+
+  /**
+   * @brief Invokes a function on every frame in the receive blocks ready for userspace,
+   *        then returns the blocks to the kernel
+   *
+   * The frame pointer is valid only during the invocation.
+   *
+   * @param f function invoked as f(const uint8_t* frame, size_t length, bool isOutgoing)
+   * @return number of frames processed
+   */
+  template<typename F>
+  size_t
+  receive(const F& f);
+
+  /**
+   * @brief Queues a frame for transmission
+   *
+   * The header and the payload are written directly into a transmit ring slot,
+   * and zero padding is appended if the frame is shorter than @p minLength.
+   *
+   * @return false if the frame cannot be sent
+   */
+  bool
+  send(const uint8_t* header, size_t headerLength,
+       const uint8_t* payload, size_t payloadLength,
+       size_t minLength);
+
+  /**
+   * @brief Hands queued frames to the kernel
+   * @return false if the kernel reported an error
+   */
+  bool
+  flush();
+
+  /**
+   * @return whether send() has queued frames that flush() has not handed to the kernel
+   */
+  bool
+  hasPendingFrames() const
+  {
+    return m_nPendingFrames > 0;
+  }
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /**
+   * @brief Processes one receive block if it is ready for userspace,
+   *        then returns it to the kernel
+   * @return number of frames in the block, or -1 if the block is not ready
+   */
+  template<typename F>
+  static int
+  receiveBlock(uint8_t* block, const F& f);
+
+private:
+  static void
+  releaseBlock(uint8_t* block);
+
+  static bool
+  isBlockReady(const uint8_t* block);
+
+  static std::tuple<const uint8_t*, size_t, bool, size_t>
+  parseFrame(const uint8_t* block, size_t offset);
+
+  static size_t
+  getFirstFrameOffset(const uint8_t* block);
+
+  static size_t
+  getNFrames(const uint8_t* block);
+
+private:
+  int m_fd;
+  uint8_t* m_map;
+  size_t m_mapSize;
+
+  uint8_t* m_rxRing;
+  size_t m_rxBlockSize;
+  size_t m_rxNBlocks;
+  size_t m_rxBlockIndex;
+
+  uint8_t* m_txRing; ///< nullptr if the transmit ring is unavailable
+  size_t m_txFrameSize;
+  size_t m_txNFrames;
+  size_t m_txFrameIndex;
+  size_t m_nPendingFrames;
+};
+
+template<typename F>
+inline size_t
+EthernetPacketRing::receive(const F& f)
+{
+  size_t nFrames = 0;
+  // visit at most one lap, so that a fast sender cannot starve other faces
+  for (size_t i = 0; i < m_rxNBlocks; ++i) {
+    int n = receiveBlock(m_rxRing + m_rxBlockIndex * m_rxBlockSize, f);
+    if (n < 0)
+      break;
+    nFrames += n;
+    m_rxBlockIndex = (m_rxBlockIndex + 1) % m_rxNBlocks;
+  }
+  return nFrames;
+}
+
+template<typename F>
+inline int
+EthernetPacketRing::receiveBlock(uint8_t* block, const F& f)
+{
+  if (!isBlockReady(block))
+    return -1;
+
+  size_t nFrames = getNFrames(block);
+  size_t offset = getFirstFrameOffset(block);
+  for (size_t i = 0; i < nFrames; ++i) {
+    const uint8_t* frame = nullptr;
+    size_t length = 0;
+    bool isOutgoing = false;
+    size_t nextOffset = 0;
+    std::tie(frame, length, isOutgoing, nextOffset) = parseFrame(block, offset);
+    f(frame, length, isOutgoing);
+    offset += nextOffset;
+  }
+
+  releaseBlock(block);
+  return static_cast<int>(nFrames);
+}
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_ETHERNET_PACKET_RING_HPP
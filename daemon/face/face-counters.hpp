@@ -212,6 +212,76 @@ public:
     return m_nOutBytes;
   }
 
+  /** \brief bytes copied while preparing outgoing packets
+   *
+   *  Divided by the number of outgoing packets, this gives the cost of the outgoing path
+   *  beyond handing the received wire encoding to the socket.
+   *  This counter is not part of FaceStatus.
+   */
+  const ByteCounter&
+  getNOutBytesCopied() const
+  {
+    return m_nOutBytesCopied;
+  }
+
+  ByteCounter&
+  getNOutBytesCopied()
+  {
+    return m_nOutBytesCopied;
+  }
+
+  /** \brief number of packets waiting in the send queue, including those being written
+   *
+   *  This is a gauge rather than a counter. It's maintained only by faces with a send queue,
+   *  and is not part of FaceStatus.
+   */
+  const PacketCounter&
+  getSendQueueLength() const
+  {
+    return m_sendQueueLength;
+  }
+
+  PacketCounter&
+  getSendQueueLength()
+  {
+    return m_sendQueueLength;
+  }
+
+  /** \brief number of bytes waiting in the send queue, including those being written
+   *
+   *  This is a gauge rather than a counter. It's maintained only by faces with a send queue,
+   *  and is not part of FaceStatus.
+   */
+  const ByteCounter&
+  getSendQueueBytes() const
+  {
+    return m_sendQueueBytes;
+  }
+
+  ByteCounter&
+  getSendQueueBytes()
+  {
+    return m_sendQueueBytes;
+  }
+
+  /** \brief number of partially received messages dropped before reassembly completes,
+   *         because of idle timeout or memory limits
+   *
+   *  This counter is maintained only by faces that reassemble fragments,
+   *  and is not part of FaceStatus.
+   */
+  const PacketCounter&
+  getNReassemblyDrops() const
+  {
+    return m_nReassemblyDrops;
+  }
+
+  PacketCounter&
+  getNReassemblyDrops()
+  {
+    return m_nReassemblyDrops;
+  }
+
 protected:
   /** \brief copy current obseverations to a struct
    *  \param recipient an object with set methods for counters
@@ -227,6 +297,10 @@ protected:
 private:
   ByteCounter m_nInBytes;
   ByteCounter m_nOutBytes;
+  ByteCounter m_nOutBytesCopied;
+  PacketCounter m_sendQueueLength;
+  ByteCounter m_sendQueueBytes;
+  PacketCounter m_nReassemblyDrops;
 };
 
 /** \brief contains counters on face
@@ -59,22 +59,33 @@ bool
 Face::decodeAndDispatchInput(const Block& element)
 {
   try {
-    /// \todo Ensure lazy field decoding process
+    if (element.type() != tlv::Interest && element.type() != tlv::Data)
+      return false;
 
+    if (this->isViolatingLocalhost(element))
+      {
+        // counted as received, but not decoded because the forwarder would drop it
+        if (element.type() == tlv::Interest)
+          ++m_counters.getNInInterests();
+        else
+          ++m_counters.getNInDatas();
+        return true;
+      }
+
+    // Interest and Data keep a reference to element, so that the original wire encoding
+    // is forwarded without being re-encoded
     if (element.type() == tlv::Interest)
       {
         shared_ptr<Interest> i = make_shared<Interest>();
         i->wireDecode(element);
         this->onReceiveInterest(*i);
       }
-    else if (element.type() == tlv::Data)
+    else
       {
         shared_ptr<Data> d = make_shared<Data>();
         d->wireDecode(element);
         this->onReceiveData(*d);
       }
-    else
-      return false;
 
     return true;
   }
@@ -83,6 +94,30 @@ Face::decodeAndDispatchInput(const Block& element)
   }
 }
 
+bool
+Face::isViolatingLocalhost(const Block& element) const
+{
+  static const char LOCALHOST_COMPONENT[] = "localhost";
+
+  if (m_isLocal)
+    return false;
+
+  element.parse();
+  Block::element_const_iterator name = element.find(tlv::Name);
+  if (name == element.elements_end())
+    return false;
+
+  name->parse();
+  if (name->elements_size() == 0)
+    return false;
+
+  const Block& firstComponent = *name->elements_begin();
+  return firstComponent.type() == tlv::NameComponent &&
+         firstComponent.value_size() == sizeof(LOCALHOST_COMPONENT) - 1 &&
+         std::equal(firstComponent.value_begin(), firstComponent.value_end(),
+                    reinterpret_cast<const uint8_t*>(LOCALHOST_COMPONENT));
+}
+
 void
 Face::fail(const std::string& reason)
 {
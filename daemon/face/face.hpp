@@ -183,6 +183,15 @@ protected:
   bool
   decodeAndDispatchInput(const Block& element);
 
+  /** \brief determine whether a received Interest or Data violates /localhost scope
+   *
+   *  Only the first name component is inspected, so that such packets, which would be
+   *  dropped by the forwarder, can be discarded before they are decoded.
+   *  A packet that cannot be parsed this far is not reported as a violation.
+   */
+  bool
+  isViolatingLocalhost(const Block& element) const;
+
   /** \brief fail the face and raise onFail event if it's UP; otherwise do nothing
    */
   void
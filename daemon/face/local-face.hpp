@@ -28,6 +28,8 @@
 
 #include "face.hpp"
 #include <ndn-cxx/management/nfd-control-parameters.hpp>
+#include <ndn-cxx/encoding/block-helpers.hpp>
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
 
 namespace nfd {
 
@@ -96,6 +98,20 @@ protected:
   Block
   filterAndEncodeLocalControlHeader(const Packet& packet);
 
+  /** \brief Create the part of LocalControlHeader preceding the packet, considering enabled
+   *         features
+   *
+   *  The returned Block contains TLV-TYPE and TLV-LENGTH of LocalControlHeader,
+   *  followed by LocalControlInfo. Sending it followed by packet.wireEncode()
+   *  is equivalent to sending filterAndEncodeLocalControlHeader(packet),
+   *  but the packet is not copied.
+   *
+   *  \return the prefix, or an empty Block if LocalControlHeader is not needed
+   */
+  template<class Packet>
+  Block
+  encodeLocalControlHeaderPrefix(const Packet& packet);
+
 private:
   std::vector<bool> m_localControlHeaderFeatures;
 };
@@ -213,6 +229,28 @@ LocalFace::filterAndEncodeLocalControlHeader(const Packet& packet)
   return packet.getLocalControlHeader().wireEncode(packet, mask);
 }
 
+template<class Packet>
+inline Block
+LocalFace::encodeLocalControlHeaderPrefix(const Packet& packet)
+{
+  const ndn::nfd::LocalControlHeader& header = packet.getLocalControlHeader();
+  if (this->isEmptyFilteredLocalControlHeader(header)) {
+    return Block();
+  }
+
+  // only IncomingFaceId applies to packets sent to the application
+  ndn::EncodingBuffer encoder;
+  size_t infoLength = ndn::prependNonNegativeIntegerBlock(encoder, ndn::tlv::nfd::IncomingFaceId,
+                                                          header.getIncomingFaceId());
+  infoLength += encoder.prependVarNumber(infoLength);
+  infoLength += encoder.prependVarNumber(ndn::tlv::nfd::LocalControlInfo);
+
+  encoder.prependVarNumber(infoLength + packet.wireEncode().size());
+  encoder.prependVarNumber(ndn::tlv::nfd::LocalControlHeader);
+
+  return encoder.block(false);
+}
+
 } // namespace nfd
 
 #endif // NFD_DAEMON_FACE_LOCAL_FACE_HPP
@@ -64,14 +64,16 @@ MulticastUdpFace::sendData(const Data& data)
   sendBlock(data.wireEncode());
 }
 
-void
-MulticastUdpFace::sendBlock(const Block& block)
+MulticastUdpFace::protocol::socket&
+MulticastUdpFace::getSendSocket()
+{
+  return m_sendSocket;
+}
+
+const MulticastUdpFace::protocol::endpoint*
+MulticastUdpFace::getSendDestination() const
 {
-  m_sendSocket.async_send_to(boost::asio::buffer(block.wire(), block.size()), m_multicastGroup,
-                             bind(&MulticastUdpFace::handleSend, this,
-                                  boost::asio::placeholders::error,
-                                  boost::asio::placeholders::bytes_transferred,
-                                  block));
+  return &m_multicastGroup;
 }
 
 } // namespace nfd
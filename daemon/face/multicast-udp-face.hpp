@@ -53,9 +53,12 @@ public:
   void
   sendData(const Data& data) DECL_OVERRIDE;
 
-private:
-  void
-  sendBlock(const Block& block);
+protected:
+  protocol::socket&
+  getSendSocket() DECL_OVERRIDE;
+
+  const protocol::endpoint*
+  getSendDestination() const DECL_OVERRIDE;
 
 private:
   protocol::endpoint m_multicastGroup;
@@ -34,6 +34,7 @@ NFD_LOG_INIT("NdnlpPartialMessageStore");
 PartialMessage::PartialMessage()
   : m_fragCount(0)
   , m_received(0)
+  , m_fragSize(0)
   , m_totalLength(0)
 {
 }
@@ -43,23 +44,71 @@ PartialMessage::add(uint16_t fragIndex, uint16_t fragCount, const Block& payload
 {
   if (m_received == 0) { // first packet
     m_fragCount = fragCount;
-    m_payloads.resize(fragCount);
+    m_isReceived.assign(fragCount, false);
   }
 
   if (m_fragCount != fragCount || fragIndex >= m_fragCount) {
     return false;
   }
 
-  if (!m_payloads[fragIndex].empty()) { // duplicate
+  if (m_isReceived[fragIndex]) { // duplicate
     return false;
   }
 
-  m_payloads[fragIndex] = payload;
+  size_t lastIndex = m_fragCount - 1;
+  if (fragIndex != lastIndex && m_fragSize == 0) {
+    // the first fragment other than the last determines fragment size and buffer size
+    size_t fragSize = payload.value_size();
+    if (fragSize == 0 || lastIndex * fragSize >= ndn::MAX_NDN_PACKET_SIZE) {
+      return false;
+    }
+    m_fragSize = fragSize;
+    m_buffer = make_shared<ndn::Buffer>(std::min(m_fragCount * m_fragSize,
+                                                 ndn::MAX_NDN_PACKET_SIZE));
+
+    if (!m_lastPayload.empty()) {
+      if (!this->copyPayload(lastIndex, m_lastPayload)) {
+        // the last fragment is inconsistent with this one, forget it
+        m_isReceived[lastIndex] = false;
+        --m_received;
+        m_totalLength -= m_lastPayload.value_size();
+      }
+      m_lastPayload = Block();
+    }
+  }
+
+  if (m_fragSize == 0) {
+    // last fragment arrived first, keep it until fragment size is known
+    m_lastPayload = payload;
+  }
+  else if (!this->copyPayload(fragIndex, payload)) {
+    return false;
+  }
+
+  m_isReceived[fragIndex] = true;
   ++m_received;
   m_totalLength += payload.value_size();
   return true;
 }
 
+bool
+PartialMessage::copyPayload(uint16_t fragIndex, const Block& payload)
+{
+  size_t offset = fragIndex * m_fragSize;
+  size_t size = payload.value_size();
+  bool isLast = fragIndex == m_fragCount - 1;
+
+  if (isLast ? (size == 0 || size > m_fragSize) : size != m_fragSize) {
+    return false;
+  }
+  if (offset + size > m_buffer->size()) {
+    return false;
+  }
+
+  std::copy(payload.value_begin(), payload.value_end(), m_buffer->begin() + offset);
+  return true;
+}
+
 bool
 PartialMessage::isComplete() const
 {
@@ -71,14 +120,19 @@ PartialMessage::reassemble()
 {
   BOOST_ASSERT(this->isComplete());
 
-  ndn::BufferPtr buffer = make_shared<ndn::Buffer>(m_totalLength);
-  ndn::Buffer::iterator buf = buffer->begin();
-  for (const Block& payload : m_payloads) {
-    buf = std::copy(payload.value_begin(), payload.value_end(), buf);
+  if (m_buffer == nullptr) { // only one fragment
+    try {
+      return std::make_tuple(true, m_lastPayload.blockFromValue());
+    }
+    catch (tlv::Error&) {
+      return std::make_tuple(false, Block());
+    }
   }
-  BOOST_ASSERT(buf == buffer->end());
 
-  return Block::fromBuffer(buffer, 0);
+  // payloads are already in place; the reassembled Block shares the buffer
+  BOOST_ASSERT(m_totalLength <= m_buffer->size());
+  m_buffer->resize(m_totalLength);
+  return Block::fromBuffer(m_buffer, 0);
 }
 
 std::tuple<bool, Block>
@@ -94,9 +148,37 @@ PartialMessage::reassembleSingle(const NdnlpData& fragment)
   }
 }
 
-PartialMessageStore::PartialMessageStore(const time::nanoseconds& idleDuration)
+size_t
+PartialMessage::getMemorySize() const
+{
+  if (m_buffer != nullptr) {
+    // capacity is unchanged when reassemble shrinks the buffer
+    return m_buffer->capacity();
+  }
+  return m_lastPayload.empty() ? 0 : m_lastPayload.size();
+}
+
+const size_t PartialMessageStore::DEFAULT_MAX_BYTES = 256 * 1024;
+
+PartialMessageStore::PartialMessageStore(const time::nanoseconds& idleDuration,
+                                         size_t maxBytes,
+                                         shared_ptr<ReassemblyMemory> sharedMemory)
   : m_idleDuration(idleDuration)
+  , m_isCleanupScheduled(false)
+  , m_maxBytes(maxBytes)
+  , m_nBytes(0)
+  , m_sharedMemory(sharedMemory)
+{
+}
+
+PartialMessageStore::~PartialMessageStore()
 {
+  if (m_sharedMemory != nullptr) {
+    m_sharedMemory->m_used -= m_nBytes;
+    for (const auto& pair : m_partialMessages) {
+      m_sharedMemory->m_lru.erase(pair.second.sharedPosition);
+    }
+  }
 }
 
 void
@@ -110,16 +192,38 @@ PartialMessageStore::receive(const NdnlpData& pkt)
   }
   else {
     uint64_t messageIdentifier = pkt.seq - pkt.fragIndex;
-    PartialMessage& pm = m_partialMessages[messageIdentifier];
-    this->scheduleCleanup(messageIdentifier, pm);
+    auto it = m_partialMessages.find(messageIdentifier);
+    if (it == m_partialMessages.end()) {
+      it = m_partialMessages.emplace(messageIdentifier, PartialMessage()).first;
+      it->second.position = m_lru.insert(m_lru.end(), messageIdentifier);
+      if (m_sharedMemory != nullptr) {
+        it->second.sharedPosition =
+          m_sharedMemory->m_lru.insert(m_sharedMemory->m_lru.end(),
+                                       std::make_pair(this, messageIdentifier));
+      }
+    }
+    else {
+      m_lru.splice(m_lru.end(), m_lru, it->second.position);
+      if (m_sharedMemory != nullptr) {
+        m_sharedMemory->m_lru.splice(m_sharedMemory->m_lru.end(), m_sharedMemory->m_lru,
+                                     it->second.sharedPosition);
+      }
+    }
+
+    PartialMessage& pm = it->second;
+    pm.lastActivity = time::steady_clock::now();
+    this->scheduleCleanup();
 
+    size_t oldSize = pm.getMemorySize();
     pm.add(pkt.fragIndex, pkt.fragCount, pkt.payload);
+    this->updateMemorySize(oldSize, pm.getMemorySize());
 
     if (pm.isComplete()) {
       std::tie(isReassembled, reassembled) = pm.reassemble();
-      m_partialMessages.erase(messageIdentifier);
+      this->erase(messageIdentifier, false);
     }
     else {
+      this->evict();
       return;
     }
   }
@@ -134,18 +238,87 @@ PartialMessageStore::receive(const NdnlpData& pkt)
 }
 
 void
-PartialMessageStore::scheduleCleanup(uint64_t messageIdentifier,
-                                     PartialMessage& partialMessage)
+PartialMessageStore::evict()
 {
-  partialMessage.expiry = scheduler::schedule(m_idleDuration,
-    bind(&PartialMessageStore::cleanup, this, messageIdentifier));
+  // drop least recently active messages of this store, which may include the current one
+  while (!m_lru.empty() && m_nBytes > m_maxBytes) {
+    NFD_LOG_TRACE(m_lru.front() << " evict");
+    this->erase(m_lru.front(), true);
+  }
+
+  if (m_sharedMemory == nullptr) {
+    return;
+  }
+
+  // drop least recently active messages of any store sharing the limit
+  std::list<std::pair<PartialMessageStore*, uint64_t>>& sharedLru = m_sharedMemory->m_lru;
+  while (!sharedLru.empty() && m_sharedMemory->m_used > m_sharedMemory->m_limit) {
+    PartialMessageStore* store = sharedLru.front().first;
+    uint64_t messageIdentifier = sharedLru.front().second;
+    NFD_LOG_TRACE(messageIdentifier << " evict shared");
+    store->erase(messageIdentifier, true);
+  }
 }
 
 void
-PartialMessageStore::cleanup(uint64_t messageIdentifier)
+PartialMessageStore::updateMemorySize(size_t oldSize, size_t newSize)
 {
-  NFD_LOG_TRACE(messageIdentifier << " cleanup");
-  m_partialMessages.erase(messageIdentifier);
+  m_nBytes = m_nBytes - oldSize + newSize;
+  if (m_sharedMemory != nullptr) {
+    m_sharedMemory->m_used = m_sharedMemory->m_used - oldSize + newSize;
+  }
+}
+
+void
+PartialMessageStore::erase(uint64_t messageIdentifier, bool isDrop)
+{
+  auto it = m_partialMessages.find(messageIdentifier);
+  BOOST_ASSERT(it != m_partialMessages.end());
+
+  this->updateMemorySize(it->second.getMemorySize(), 0);
+  m_lru.erase(it->second.position);
+  if (m_sharedMemory != nullptr) {
+    m_sharedMemory->m_lru.erase(it->second.sharedPosition);
+  }
+  m_partialMessages.erase(it);
+
+  if (isDrop) {
+    this->onDrop();
+  }
+}
+
+void
+PartialMessageStore::scheduleCleanup()
+{
+  // a single event serves all partial messages; it's rescheduled by cleanup
+  // as long as the store is not empty
+  if (m_isCleanupScheduled) {
+    return;
+  }
+
+  m_isCleanupScheduled = true;
+  m_cleanupEvent = scheduler::schedule(m_idleDuration,
+                                       bind(&PartialMessageStore::cleanup, this));
+}
+
+void
+PartialMessageStore::cleanup()
+{
+  m_isCleanupScheduled = false;
+
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  while (!m_lru.empty()) {
+    const PartialMessage& pm = m_partialMessages.at(m_lru.front());
+    if (pm.lastActivity + m_idleDuration > now) {
+      m_isCleanupScheduled = true;
+      m_cleanupEvent = scheduler::schedule(pm.lastActivity + m_idleDuration - now,
+                                           bind(&PartialMessageStore::cleanup, this));
+      return;
+    }
+
+    NFD_LOG_TRACE(m_lru.front() << " cleanup");
+    this->erase(m_lru.front(), true);
+  }
 }
 
 } // namespace ndnlp
@@ -29,10 +29,20 @@
 #include "ndnlp-data.hpp"
 #include "core/scheduler.hpp"
 
+#include <list>
+
 namespace nfd {
 namespace ndnlp {
 
+class PartialMessageStore;
+
 /** \brief represents a partially received message
+ *
+ *  Fragment payloads are copied into a per-message buffer as they arrive,
+ *  and the reassembled network layer packet is a view of that buffer.
+ *  All fragments except the last must have the same payload size, which is how
+ *  the Slicer fragments packets; the buffer is allocated when a fragment other than
+ *  the last arrives, and is no larger than ndn::MAX_NDN_PACKET_SIZE.
  */
 class PartialMessage
 {
@@ -49,6 +59,10 @@ public:
   PartialMessage&
   operator=(PartialMessage&&) = default;
 
+  /** \brief add a fragment
+   *  \return false if the fragment is a duplicate, is inconsistent with earlier fragments,
+   *          or would make the network layer packet larger than ndn::MAX_NDN_PACKET_SIZE
+   */
   bool
   add(uint16_t fragIndex, uint16_t fragCount, const Block& payload);
 
@@ -69,23 +83,98 @@ public:
   static std::tuple<bool, Block>
   reassembleSingle(const NdnlpData& fragment);
 
+  /** \return number of octets held by this partial message
+   */
+  size_t
+  getMemorySize() const;
+
 public:
-  scheduler::ScopedEventId expiry;
+  /// when the last fragment was added
+  time::steady_clock::TimePoint lastActivity;
+
+  /// position in PartialMessageStore's list of messages, least recently active first
+  std::list<uint64_t>::iterator position;
+
+  /// position in ReassemblyMemory's list of messages, if the store has a ReassemblyMemory
+  std::list<std::pair<PartialMessageStore*, uint64_t>>::iterator sharedPosition;
+
+private:
+  bool
+  copyPayload(uint16_t fragIndex, const Block& payload);
 
 private:
   size_t m_fragCount;
   size_t m_received;
-  std::vector<Block> m_payloads;
+  std::vector<bool> m_isReceived;
+
+  /// payload size of every fragment except the last, zero if not yet known
+  size_t m_fragSize;
+  ndn::BufferPtr m_buffer;
   size_t m_totalLength;
+
+  /// payload of the last fragment, if it arrived before the fragment size is known
+  Block m_lastPayload;
+};
+
+/** \brief limits memory used by partial messages in several PartialMessageStores
+ *
+ *  When the limit is exceeded, the least recently active partial messages
+ *  are dropped, regardless of which store they belong to.
+ */
+class ReassemblyMemory : noncopyable
+{
+public:
+  explicit
+  ReassemblyMemory(size_t limit)
+    : m_limit(limit)
+    , m_used(0)
+  {
+  }
+
+  size_t
+  getLimit() const
+  {
+    return m_limit;
+  }
+
+  size_t
+  getUsed() const
+  {
+    return m_used;
+  }
+
+private:
+  size_t m_limit;
+  size_t m_used;
+
+  /// store and identifier of every partial message, least recently active first
+  std::list<std::pair<PartialMessageStore*, uint64_t>> m_lru;
+
+  friend class PartialMessageStore;
 };
 
 /** \brief provides reassembly feature at receiver
+ *
+ *  Memory held by partial messages is limited per store, and optionally by a
+ *  ReassemblyMemory shared with other stores. When the per-store limit is exceeded,
+ *  the least recently active partial messages of this store are dropped.
+ *  When the shared limit is exceeded, the least recently active partial messages
+ *  of all sharing stores are dropped, so that a sender flooding its own store
+ *  cannot prevent other senders from completing their messages.
  */
 class PartialMessageStore : noncopyable
 {
 public:
+  /** \param idleDuration a partial message is dropped if no fragment arrives within this duration
+   *  \param maxBytes limit of memory held by partial messages in this store
+   *  \param sharedMemory limit shared with other stores, optional
+   */
   explicit
-  PartialMessageStore(const time::nanoseconds& idleDuration = time::milliseconds(100));
+  PartialMessageStore(const time::nanoseconds& idleDuration = time::milliseconds(100),
+                      size_t maxBytes = DEFAULT_MAX_BYTES,
+                      shared_ptr<ReassemblyMemory> sharedMemory = nullptr);
+
+  ~PartialMessageStore();
 
   /** \brief receive a NdnlpData packet
    *
@@ -94,21 +183,57 @@ public:
   void
   receive(const NdnlpData& pkt);
 
+  /** \return number of octets held by partial messages in this store
+   */
+  size_t
+  getMemorySize() const
+  {
+    return m_nBytes;
+  }
+
   /** \brief fires when network layer packet is received
    */
   signal::Signal<PartialMessageStore, Block> onReceive;
 
+  /** \brief fires when a partial message is dropped before completion,
+   *         because of idle timeout or memory limits
+   */
+  signal::Signal<PartialMessageStore> onDrop;
+
+public:
+  static const size_t DEFAULT_MAX_BYTES;
+
 private:
+  /** \brief drop least recently active partial messages until memory limits are met
+   */
+  void
+  evict();
+
+  /** \brief adjust memory accounting after the size of a partial message changes
+   */
   void
-  scheduleCleanup(uint64_t messageIdentifier, PartialMessage& partialMessage);
+  updateMemorySize(size_t oldSize, size_t newSize);
 
   void
-  cleanup(uint64_t messageIdentifier);
+  erase(uint64_t messageIdentifier, bool isDrop);
+
+  void
+  scheduleCleanup();
+
+  void
+  cleanup();
 
 private:
   std::unordered_map<uint64_t, PartialMessage> m_partialMessages;
+  std::list<uint64_t> m_lru;
 
   time::nanoseconds m_idleDuration;
+  scheduler::ScopedEventId m_cleanupEvent;
+  bool m_isCleanupScheduled;
+
+  size_t m_maxBytes;
+  size_t m_nBytes;
+  shared_ptr<ReassemblyMemory> m_sharedMemory;
 };
 
 } // namespace ndnlp
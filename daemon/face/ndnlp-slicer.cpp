@@ -30,6 +30,53 @@
 namespace nfd {
 namespace ndnlp {
 
+const size_t Slicer::MAX_HEADER_SIZE;
+
+static uint8_t*
+writeVarNumber(uint8_t* pos, uint64_t number)
+{
+  if (number < 253) {
+    *pos++ = static_cast<uint8_t>(number);
+  }
+  else if (number <= std::numeric_limits<uint16_t>::max()) {
+    *pos++ = 253;
+    uint16_t value = htobe16(static_cast<uint16_t>(number));
+    std::memcpy(pos, &value, sizeof(value));
+    pos += sizeof(value);
+  }
+  else if (number <= std::numeric_limits<uint32_t>::max()) {
+    *pos++ = 254;
+    uint32_t value = htobe32(static_cast<uint32_t>(number));
+    std::memcpy(pos, &value, sizeof(value));
+    pos += sizeof(value);
+  }
+  else {
+    *pos++ = 255;
+    uint64_t value = htobe64(number);
+    std::memcpy(pos, &value, sizeof(value));
+    pos += sizeof(value);
+  }
+  return pos;
+}
+
+static uint8_t*
+writeUint16Element(uint8_t* pos, uint32_t type, uint16_t number)
+{
+  // NonNegativeInteger encoding, same as prependNonNegativeInteger
+  pos = writeVarNumber(pos, type);
+  if (number <= std::numeric_limits<uint8_t>::max()) {
+    pos = writeVarNumber(pos, 1);
+    *pos++ = static_cast<uint8_t>(number);
+  }
+  else {
+    pos = writeVarNumber(pos, 2);
+    uint16_t value = htobe16(number);
+    std::memcpy(pos, &value, sizeof(value));
+    pos += sizeof(value);
+  }
+  return pos;
+}
+
 Slicer::Slicer(size_t mtu)
   : m_mtu(mtu)
 {
@@ -84,6 +131,53 @@ Slicer::encodeFragment(ndn::EncodingImpl<T>& blk,
   return totalLength;
 }
 
+size_t
+Slicer::encodeFragmentHeader(uint8_t* buf,
+                             uint64_t seq, uint16_t fragIndex, uint16_t fragCount,
+                             size_t payloadSize)
+{
+  // field order and encoding are the same as encodeFragment
+  bool needFragIndexAndCount = fragCount > 1;
+  size_t dataLength =
+    ndn::tlv::sizeOfVarNumber(tlv::NdnlpSequence) + ndn::tlv::sizeOfVarNumber(sizeof(seq)) +
+    sizeof(seq) +
+    ndn::tlv::sizeOfVarNumber(tlv::NdnlpPayload) + ndn::tlv::sizeOfVarNumber(payloadSize) +
+    payloadSize;
+  if (needFragIndexAndCount) {
+    dataLength += ndn::tlv::sizeOfVarNumber(tlv::NdnlpFragIndex) +
+                  ndn::tlv::sizeOfVarNumber(ndn::tlv::sizeOfNonNegativeInteger(fragIndex)) +
+                  ndn::tlv::sizeOfNonNegativeInteger(fragIndex) +
+                  ndn::tlv::sizeOfVarNumber(tlv::NdnlpFragCount) +
+                  ndn::tlv::sizeOfVarNumber(ndn::tlv::sizeOfNonNegativeInteger(fragCount)) +
+                  ndn::tlv::sizeOfNonNegativeInteger(fragCount);
+  }
+
+  uint8_t* pos = buf;
+
+  // NdnlpData
+  pos = writeVarNumber(pos, tlv::NdnlpData);
+  pos = writeVarNumber(pos, dataLength);
+
+  // NdnlpSequence
+  uint64_t sequenceBE = htobe64(seq);
+  pos = writeVarNumber(pos, tlv::NdnlpSequence);
+  pos = writeVarNumber(pos, sizeof(sequenceBE));
+  std::memcpy(pos, &sequenceBE, sizeof(sequenceBE));
+  pos += sizeof(sequenceBE);
+
+  if (needFragIndexAndCount) {
+    pos = writeUint16Element(pos, tlv::NdnlpFragIndex, fragIndex);
+    pos = writeUint16Element(pos, tlv::NdnlpFragCount, fragCount);
+  }
+
+  // NdnlpPayload, without the payload itself
+  pos = writeVarNumber(pos, tlv::NdnlpPayload);
+  pos = writeVarNumber(pos, payloadSize);
+
+  BOOST_ASSERT(static_cast<size_t>(pos - buf) <= MAX_HEADER_SIZE);
+  return pos - buf;
+}
+
 void
 Slicer::estimateOverhead()
 {
@@ -96,6 +190,7 @@ Slicer::estimateOverhead()
                                               nullptr, m_mtu);
 
   size_t overhead = estimatedSize - m_mtu; // minus payload length in estimation
+  BOOST_ASSERT(overhead <= MAX_HEADER_SIZE);
   m_maxPayload = m_mtu - overhead;
 }
 
@@ -131,5 +226,40 @@ Slicer::slice(const Block& block)
   return pa;
 }
 
+const FragmentArray&
+Slicer::sliceInPlace(const Block& block)
+{
+  BOOST_ASSERT(block.hasWire());
+  const uint8_t* networkPacket = block.wire();
+  size_t networkPacketSize = block.size();
+
+  uint16_t fragCount = static_cast<uint16_t>(
+                         (networkPacketSize / m_maxPayload) +
+                         (networkPacketSize % m_maxPayload == 0 ? 0 : 1)
+                       );
+  if (m_headers.size() < fragCount * MAX_HEADER_SIZE) {
+    m_headers.resize(fragCount * MAX_HEADER_SIZE);
+  }
+  m_fragments.clear();
+  SequenceBlock seqBlock = m_seqgen.nextBlock(fragCount);
+
+  for (uint16_t fragIndex = 0; fragIndex < fragCount; ++fragIndex) {
+    size_t payloadOffset = fragIndex * m_maxPayload;
+
+    Fragment fragment;
+    fragment.header = &m_headers[fragIndex * MAX_HEADER_SIZE];
+    fragment.payload = networkPacket + payloadOffset;
+    fragment.payloadSize = std::min(m_maxPayload, networkPacketSize - payloadOffset);
+    fragment.headerSize = encodeFragmentHeader(&m_headers[fragIndex * MAX_HEADER_SIZE],
+                                               seqBlock[fragIndex], fragIndex, fragCount,
+                                               fragment.payloadSize);
+
+    BOOST_ASSERT(fragment.size() <= m_mtu);
+    m_fragments.push_back(fragment);
+  }
+
+  return m_fragments;
+}
+
 } // namespace ndnlp
 } // namespace nfd
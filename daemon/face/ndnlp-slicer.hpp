@@ -34,6 +34,27 @@ namespace ndnlp {
 
 typedef shared_ptr<std::vector<Block>> PacketArray;
 
+/** \brief an NDNLP fragment represented as its header and a view of its payload
+ *
+ *  The fragment is the concatenation of header and payload.
+ *  The payload points into the wire encoding of the sliced network layer packet.
+ */
+struct Fragment
+{
+  const uint8_t* header;
+  size_t headerSize;
+  const uint8_t* payload;
+  size_t payloadSize;
+
+  size_t
+  size() const
+  {
+    return headerSize + payloadSize;
+  }
+};
+
+typedef std::vector<Fragment> FragmentArray;
+
 /** \brief provides fragmentation feature at sender
  */
 class Slicer : noncopyable
@@ -49,9 +70,25 @@ public:
   virtual
   ~Slicer();
 
+  /** \brief slices a network layer packet into fragments, copying each fragment
+   */
   PacketArray
   slice(const Block& block);
 
+  /** \brief slices a network layer packet into fragments without copying its payload
+   *
+   *  Headers are encoded into storage owned by the slicer, and the fragment array
+   *  is reused across invocations, so no memory is allocated in steady state.
+   *  \return fragments, valid until the next invocation of sliceInPlace,
+   *          as long as the wire encoding of \p block is alive
+   */
+  const FragmentArray&
+  sliceInPlace(const Block& block);
+
+public:
+  /// upper bound of NDNLP header size
+  static const size_t MAX_HEADER_SIZE = 40;
+
 private:
   template<bool T>
   size_t
@@ -59,6 +96,15 @@ private:
                  uint64_t seq, uint16_t fragIndex, uint16_t fragCount,
                  const uint8_t* payload, size_t payloadSize);
 
+  /** \brief encodes NDNLP header of a fragment
+   *  \param buf output buffer of at least MAX_HEADER_SIZE octets
+   *  \return header size
+   */
+  static size_t
+  encodeFragmentHeader(uint8_t* buf,
+                       uint64_t seq, uint16_t fragIndex, uint16_t fragCount,
+                       size_t payloadSize);
+
   /// estimate the size of NDNLP header and maximum payload size per packet
   void
   estimateOverhead();
@@ -71,6 +117,12 @@ private:
 
   /// maximum payload size
   size_t m_maxPayload;
+
+  /// headers of fragments returned by sliceInPlace, MAX_HEADER_SIZE octets each
+  std::vector<uint8_t> m_headers;
+
+  /// fragments returned by sliceInPlace
+  FragmentArray m_fragments;
 };
 
 } // namespace ndnlp
@@ -30,6 +30,8 @@
 #include "local-face.hpp"
 #include "core/global-io.hpp"
 
+#include <deque>
+
 namespace nfd {
 
 // forward declaration
@@ -58,6 +60,14 @@ protected:
   void
   processErrorCode(const boost::system::error_code& error);
 
+  /** \brief enqueue a packet, and start writing if no write is in progress
+   */
+  void
+  enqueue(Block&& prefix, const Block& packet);
+
+  /** \brief write as many queued packets as allowed by MAX_SEND_BATCH_SIZE
+   *         in a single gathered write
+   */
   void
   sendFromQueue();
 
@@ -69,6 +79,20 @@ protected:
   handleReceive(const boost::system::error_code& error,
                 size_t nBytesReceived);
 
+  /** \brief start reading into the free space at the end of the input buffer
+   */
+  void
+  receiveIntoInputBuffer();
+
+  /** \brief ensure the input buffer can hold a full packet after the unparsed bytes
+   *
+   *  The unparsed bytes are moved to the front of the buffer only when the space after them
+   *  is too small for a packet of MAX_NDN_PACKET_SIZE. If Blocks parsed earlier still reference
+   *  the buffer, a new buffer is allocated instead.
+   */
+  void
+  prepareInputBuffer();
+
   void
   shutdownSocket();
 
@@ -81,9 +105,56 @@ protected:
   NFD_LOG_INCLASS_DECLARE();
 
 private:
-  uint8_t m_inputBuffer[ndn::MAX_NDN_PACKET_SIZE];
-  size_t m_inputBufferSize;
-  std::queue<Block> m_sendQueue;
+  /** \brief input buffer shared with received Blocks
+   *
+   *  Received Blocks reference this buffer instead of copying out of it,
+   *  so a buffer stays alive as long as any packet received into it.
+   */
+  shared_ptr<ndn::Buffer> m_inputBuffer;
+
+  /** \brief offset of the first unparsed byte in m_inputBuffer
+   */
+  size_t m_inputBufferBegin;
+
+  /** \brief offset past the last received byte in m_inputBuffer
+   */
+  size_t m_inputBufferEnd;
+
+  /** \brief size of each input buffer
+   *
+   *  A single read can pick up several packets.
+   */
+  static const size_t INPUT_BUFFER_SIZE = 4 * ndn::MAX_NDN_PACKET_SIZE;
+
+  /** \brief an outgoing packet
+   *
+   *  The packet's own wire encoding is sent as is, gathered with an optional prefix
+   *  (such as LocalControlHeader) in a single write.
+   */
+  struct OutgoingPacket
+  {
+    Block prefix;
+    Block packet;
+
+    size_t
+    size() const
+    {
+      return (prefix.hasWire() ? prefix.size() : 0) + packet.size();
+    }
+  };
+  std::deque<OutgoingPacket> m_sendQueue;
+  size_t m_sendQueueBytes;
+
+  /** \brief number of packets at the front of m_sendQueue being written
+   */
+  size_t m_nSendingPackets;
+  std::vector<boost::asio::const_buffer> m_sendBuffers;
+
+  /** \brief maximum number of bytes gathered into one write
+   *
+   *  A write contains at least one packet, even if it exceeds this limit.
+   */
+  static const size_t MAX_SEND_BATCH_SIZE = 65536;
 
   friend struct StreamFaceSenderImpl<Protocol, FaceBase, Interest>;
   friend struct StreamFaceSenderImpl<Protocol, FaceBase, Data>;
@@ -116,17 +187,18 @@ StreamFace<T, FaceBase>::StreamFace(const FaceUri& remoteUri, const FaceUri& loc
                                     typename StreamFace::protocol::socket socket, bool isOnDemand)
   : FaceBase(remoteUri, localUri)
   , m_socket(std::move(socket))
-  , m_inputBufferSize(0)
+  , m_inputBuffer(make_shared<ndn::Buffer>(INPUT_BUFFER_SIZE))
+  , m_inputBufferBegin(0)
+  , m_inputBufferEnd(0)
+  , m_sendQueueBytes(0)
+  , m_nSendingPackets(0)
 {
   NFD_LOG_FACE_INFO("Creating face");
 
   this->setPersistency(isOnDemand ? ndn::nfd::FACE_PERSISTENCY_ON_DEMAND : ndn::nfd::FACE_PERSISTENCY_PERSISTENT);
   StreamFaceValidator<T, FaceBase>::validateSocket(m_socket);
 
-  m_socket.async_receive(boost::asio::buffer(m_inputBuffer, ndn::MAX_NDN_PACKET_SIZE),
-                         bind(&StreamFace<T, FaceBase>::handleReceive, this,
-                              boost::asio::placeholders::error,
-                              boost::asio::placeholders::bytes_transferred));
+  receiveIntoInputBuffer();
 }
 
 
@@ -136,11 +208,7 @@ struct StreamFaceSenderImpl
   static void
   send(StreamFace<Protocol, FaceBase>& face, const Packet& packet)
   {
-    bool wasQueueEmpty = face.m_sendQueue.empty();
-    face.m_sendQueue.push(packet.wireEncode());
-
-    if (wasQueueEmpty)
-      face.sendFromQueue();
+    face.enqueue(Block(), packet.wireEncode());
   }
 };
 
@@ -151,16 +219,7 @@ struct StreamFaceSenderImpl<Protocol, LocalFace, Packet>
   static void
   send(StreamFace<Protocol, LocalFace>& face, const Packet& packet)
   {
-    bool wasQueueEmpty = face.m_sendQueue.empty();
-
-    if (!face.isEmptyFilteredLocalControlHeader(packet.getLocalControlHeader()))
-      {
-        face.m_sendQueue.push(face.filterAndEncodeLocalControlHeader(packet));
-      }
-    face.m_sendQueue.push(packet.wireEncode());
-
-    if (wasQueueEmpty)
-      face.sendFromQueue();
+    face.enqueue(face.encodeLocalControlHeaderPrefix(packet), packet.wireEncode());
   }
 };
 
@@ -221,11 +280,42 @@ StreamFace<T, U>::processErrorCode(const boost::system::error_code& error)
     this->fail(error.message());
 }
 
+template<class T, class U>
+inline void
+StreamFace<T, U>::enqueue(Block&& prefix, const Block& packet)
+{
+  bool wasQueueEmpty = m_sendQueue.empty();
+
+  m_sendQueue.push_back({std::move(prefix), packet});
+  m_sendQueueBytes += m_sendQueue.back().size();
+  this->getMutableCounters().getSendQueueLength().set(m_sendQueue.size());
+  this->getMutableCounters().getSendQueueBytes().set(m_sendQueueBytes);
+
+  if (wasQueueEmpty)
+    sendFromQueue();
+}
+
 template<class T, class U>
 inline void
 StreamFace<T, U>::sendFromQueue()
 {
-  boost::asio::async_write(m_socket, boost::asio::buffer(m_sendQueue.front()),
+  BOOST_ASSERT(!m_sendQueue.empty());
+  BOOST_ASSERT(m_nSendingPackets == 0);
+
+  m_sendBuffers.clear();
+  size_t batchSize = 0;
+  for (const OutgoingPacket& outgoing : m_sendQueue) {
+    if (m_nSendingPackets > 0 && batchSize + outgoing.size() > MAX_SEND_BATCH_SIZE)
+      break;
+
+    if (outgoing.prefix.hasWire())
+      m_sendBuffers.push_back(boost::asio::const_buffer(outgoing.prefix));
+    m_sendBuffers.push_back(boost::asio::const_buffer(outgoing.packet));
+    batchSize += outgoing.size();
+    ++m_nSendingPackets;
+  }
+
+  boost::asio::async_write(m_socket, m_sendBuffers,
                            bind(&StreamFace<T, U>::handleSend, this,
                                 boost::asio::placeholders::error,
                                 boost::asio::placeholders::bytes_transferred));
@@ -241,10 +331,17 @@ StreamFace<T, U>::handleSend(const boost::system::error_code& error,
 
   BOOST_ASSERT(!m_sendQueue.empty());
 
-  NFD_LOG_FACE_TRACE("Successfully sent: " << nBytesSent << " bytes");
+  NFD_LOG_FACE_TRACE("Successfully sent: " << nBytesSent << " bytes in " <<
+                     m_nSendingPackets << " packets");
   this->getMutableCounters().getNOutBytes() += nBytesSent;
 
-  m_sendQueue.pop();
+  BOOST_ASSERT(m_nSendingPackets <= m_sendQueue.size());
+  m_sendQueue.erase(m_sendQueue.begin(), m_sendQueue.begin() + m_nSendingPackets);
+  m_nSendingPackets = 0;
+  m_sendQueueBytes -= nBytesSent;
+  this->getMutableCounters().getSendQueueLength().set(m_sendQueue.size());
+  this->getMutableCounters().getSendQueueBytes().set(m_sendQueueBytes);
+
   if (!m_sendQueue.empty())
     sendFromQueue();
 }
@@ -260,20 +357,53 @@ StreamFace<T, U>::handleReceive(const boost::system::error_code& error,
   NFD_LOG_FACE_TRACE("Received: " << nBytesReceived << " bytes");
   this->getMutableCounters().getNInBytes() += nBytesReceived;
 
-  m_inputBufferSize += nBytesReceived;
+  m_inputBufferEnd += nBytesReceived;
+  BOOST_ASSERT(m_inputBufferEnd <= m_inputBuffer->size());
+
+  const uint8_t* const bufferBegin = m_inputBuffer->buf();
+  const uint8_t* const dataEnd = bufferBegin + m_inputBufferEnd;
+
+  while (m_inputBufferBegin < m_inputBufferEnd) {
+    // find the end of the next TLV element without copying it
+    const uint8_t* pos = bufferBegin + m_inputBufferBegin;
+    uint64_t type = 0;
+    uint64_t length = 0;
+    if (!ndn::tlv::readVarNumber(pos, dataEnd, type) ||
+        !ndn::tlv::readVarNumber(pos, dataEnd, length)) {
+      if (m_inputBufferEnd - m_inputBufferBegin >= ndn::MAX_NDN_PACKET_SIZE) {
+        NFD_LOG_FACE_WARN("Failed to parse incoming packet");
+        shutdownSocket();
+        this->fail("Failed to parse incoming packet");
+        return;
+      }
+      break;
+    }
 
-  size_t offset = 0;
+    size_t headerSize = pos - (bufferBegin + m_inputBufferBegin);
+    if (length > ndn::MAX_NDN_PACKET_SIZE - headerSize) {
+      NFD_LOG_FACE_WARN("Incoming packet too large to process");
+      shutdownSocket();
+      this->fail("Incoming packet too large to process");
+      return;
+    }
 
-  bool isOk = true;
-  Block element;
-  while (m_inputBufferSize - offset > 0) {
-    std::tie(isOk, element) = Block::fromBuffer(m_inputBuffer + offset, m_inputBufferSize - offset);
-    if (!isOk)
+    size_t elementEnd = m_inputBufferBegin + headerSize + length;
+    if (elementEnd > m_inputBufferEnd)
       break;
 
-    offset += element.size();
-
-    BOOST_ASSERT(offset <= m_inputBufferSize);
+    Block element;
+    try {
+      element = Block(m_inputBuffer,
+                      m_inputBuffer->begin() + m_inputBufferBegin,
+                      m_inputBuffer->begin() + elementEnd);
+    }
+    catch (const ndn::tlv::Error& e) {
+      NFD_LOG_FACE_WARN("Failed to parse incoming packet: " << e.what());
+      shutdownSocket();
+      this->fail("Failed to parse incoming packet");
+      return;
+    }
+    m_inputBufferBegin = elementEnd;
 
     if (!this->decodeAndDispatchInput(element)) {
       NFD_LOG_FACE_WARN("Received unrecognized TLV block of type " << element.type());
@@ -281,35 +411,49 @@ StreamFace<T, U>::handleReceive(const boost::system::error_code& error,
     }
   }
 
-  if (!isOk && m_inputBufferSize == ndn::MAX_NDN_PACKET_SIZE && offset == 0)
-    {
-      NFD_LOG_FACE_WARN("Failed to parse incoming packet or packet too large to process");
-      shutdownSocket();
-      this->fail("Failed to parse incoming packet or packet too large to process");
-      return;
-    }
-
-  if (offset > 0)
-    {
-      if (offset != m_inputBufferSize)
-        {
-          std::copy(m_inputBuffer + offset, m_inputBuffer + m_inputBufferSize,
-                    m_inputBuffer);
-          m_inputBufferSize -= offset;
-        }
-      else
-        {
-          m_inputBufferSize = 0;
-        }
-    }
+  prepareInputBuffer();
+  receiveIntoInputBuffer();
+}
 
-  m_socket.async_receive(boost::asio::buffer(m_inputBuffer + m_inputBufferSize,
-                                             ndn::MAX_NDN_PACKET_SIZE - m_inputBufferSize),
+template<class T, class U>
+inline void
+StreamFace<T, U>::receiveIntoInputBuffer()
+{
+  m_socket.async_receive(boost::asio::buffer(m_inputBuffer->buf() + m_inputBufferEnd,
+                                             m_inputBuffer->size() - m_inputBufferEnd),
                          bind(&StreamFace<T, U>::handleReceive, this,
                               boost::asio::placeholders::error,
                               boost::asio::placeholders::bytes_transferred));
 }
 
+template<class T, class U>
+inline void
+StreamFace<T, U>::prepareInputBuffer()
+{
+  size_t nUnparsedBytes = m_inputBufferEnd - m_inputBufferBegin;
+
+  if (nUnparsedBytes == 0 && m_inputBuffer.unique()) {
+    // nothing references the buffer, start over from the front
+    m_inputBufferBegin = m_inputBufferEnd = 0;
+    return;
+  }
+
+  if (m_inputBuffer->size() - m_inputBufferBegin >= ndn::MAX_NDN_PACKET_SIZE)
+    return;
+
+  // the partial packet cannot be completed in place
+  shared_ptr<ndn::Buffer> newBuffer = m_inputBuffer;
+  if (!m_inputBuffer.unique())
+    newBuffer = make_shared<ndn::Buffer>(INPUT_BUFFER_SIZE);
+
+  std::copy(m_inputBuffer->begin() + m_inputBufferBegin,
+            m_inputBuffer->begin() + m_inputBufferEnd,
+            newBuffer->begin());
+  m_inputBuffer = newBuffer;
+  m_inputBufferBegin = 0;
+  m_inputBufferEnd = nUnparsedBytes;
+}
+
 template<class T, class U>
 inline void
 StreamFace<T, U>::shutdownSocket()
@@ -348,8 +492,11 @@ StreamFace<T, U>::deferredClose(const shared_ptr<Face>& face)
   NFD_LOG_FACE_TRACE(__func__);
 
   // clear send queue
-  std::queue<Block> emptyQueue;
-  std::swap(emptyQueue, m_sendQueue);
+  m_sendQueue.clear();
+  m_sendQueueBytes = 0;
+  m_nSendingPackets = 0;
+  this->getMutableCounters().getSendQueueLength().set(0);
+  this->getMutableCounters().getSendQueueBytes().set(0);
 
   // use the non-throwing variant and ignore errors, if any
   boost::system::error_code error;
@@ -27,19 +27,90 @@
 #include "udp-face.hpp"
 #include "core/global-io.hpp"
 
+#include <boost/functional/hash.hpp>
+
+#include <cerrno>       // for errno
+#include <cstring>      // for std::strerror()
+#include <netinet/in.h> // for IP_MTU_DISCOVER and IP_PMTUDISC_DONT
+#include <sys/socket.h> // for setsockopt() and SO_REUSEPORT
+
 namespace nfd {
 
 NFD_LOG_INIT("UdpChannel");
 
 using namespace boost::asio;
 
+namespace udp {
+
+size_t
+EndpointHash::operator()(const Endpoint& endpoint) const
+{
+  size_t seed = 0;
+  const ip::address& address = endpoint.address();
+  if (address.is_v4()) {
+    boost::hash_combine(seed, address.to_v4().to_ulong());
+  }
+  else {
+    ip::address_v6::bytes_type bytes = address.to_v6().to_bytes();
+    boost::hash_range(seed, bytes.begin(), bytes.end());
+    boost::hash_combine(seed, address.to_v6().scope_id());
+  }
+  boost::hash_combine(seed, endpoint.port());
+  return seed;
+}
+
+} // namespace udp
+
+/** \brief enable SO_REUSEPORT on a socket
+ *  \throw boost::system::system_error the option cannot be set
+ */
+static void
+setReusePort(ip::udp::socket& socket)
+{
+#ifdef SO_REUSEPORT
+  const int value = 1;
+  if (::setsockopt(socket.native_handle(), SOL_SOCKET, SO_REUSEPORT, &value, sizeof(value)) < 0) {
+    BOOST_THROW_EXCEPTION(boost::system::system_error(errno, boost::system::system_category(),
+                                                      "setsockopt(SO_REUSEPORT)"));
+  }
+#endif // SO_REUSEPORT
+}
+
+/** \brief disable path MTU discovery on a socket, like UdpFace does on its own socket
+ *
+ *  Listen sockets send datagrams of faces that share them.
+ */
+static void
+disablePathMtuDiscovery(ip::udp::socket& socket)
+{
+#ifdef __linux__
+  const int value = IP_PMTUDISC_DONT;
+  if (::setsockopt(socket.native_handle(), IPPROTO_IP, IP_MTU_DISCOVER, &value, sizeof(value)) < 0) {
+    NFD_LOG_WARN("Failed to disable path MTU discovery: " << std::strerror(errno));
+  }
+#endif // __linux__
+}
+
 UdpChannel::UdpChannel(const udp::Endpoint& localEndpoint,
-                       const time::seconds& timeout)
+                       const time::seconds& timeout,
+                       size_t nListenSockets)
   : m_localEndpoint(localEndpoint)
-  , m_socket(getGlobalIoService())
+  , m_nListenSockets(std::max<size_t>(nListenSockets, 1))
   , m_idleFaceTimeout(timeout)
+  , m_maxAggregateSize(0)
+  , m_aggregationDelay(time::microseconds::zero())
+  , m_wantSharedSocketFaces(false)
+  , m_isCloseIdleFacesScheduled(false)
 {
   setUri(FaceUri(m_localEndpoint));
+
+#ifndef SO_REUSEPORT
+  if (m_nListenSockets > 1) {
+    NFD_LOG_WARN("[" << m_localEndpoint << "] SO_REUSEPORT is not supported, "
+                 "using a single listen socket");
+    m_nListenSockets = 1;
+  }
+#endif // SO_REUSEPORT
 }
 
 void
@@ -51,18 +122,26 @@ UdpChannel::listen(const FaceCreatedCallback& onFaceCreated,
     return;
   }
 
-  m_socket.open(m_localEndpoint.protocol());
-  m_socket.set_option(ip::udp::socket::reuse_address(true));
-  if (m_localEndpoint.address().is_v6())
-    m_socket.set_option(ip::v6_only(true));
+  m_sockets.reserve(m_nListenSockets);
+  for (size_t i = 0; i < m_nListenSockets; ++i) {
+    m_sockets.emplace_back(getGlobalIoService());
+    ip::udp::socket& socket = m_sockets.back();
+
+    socket.open(m_localEndpoint.protocol());
+    socket.set_option(ip::udp::socket::reuse_address(true));
+    if (m_nListenSockets > 1)
+      setReusePort(socket);
+    if (m_localEndpoint.address().is_v6())
+      socket.set_option(ip::v6_only(true));
+
+    socket.bind(m_localEndpoint);
+    disablePathMtuDiscovery(socket);
+  }
+
+  NFD_LOG_DEBUG("[" << m_localEndpoint << "] Listening on " << m_nListenSockets << " sockets");
 
-  m_socket.bind(m_localEndpoint);
-  m_socket.async_receive_from(boost::asio::buffer(m_inputBuffer, ndn::MAX_NDN_PACKET_SIZE),
-                              m_remoteEndpoint,
-                              bind(&UdpChannel::handleNewPeer, this,
-                                   boost::asio::placeholders::error,
-                                   boost::asio::placeholders::bytes_transferred,
-                                   onFaceCreated, onReceiveFailed));
+  for (size_t i = 0; i < m_nListenSockets; ++i)
+    startReceive(i, onFaceCreated, onReceiveFailed);
 }
 
 void
@@ -87,6 +166,19 @@ UdpChannel::connect(const udp::Endpoint& remoteEndpoint,
   onFaceCreated(face);
 }
 
+void
+UdpChannel::enableSharedSocketFaces()
+{
+  m_wantSharedSocketFaces = true;
+}
+
+void
+UdpChannel::enableAggregation(size_t maxDatagramSize, const time::microseconds& flushDelay)
+{
+  m_maxAggregateSize = maxDatagramSize;
+  m_aggregationDelay = flushDelay;
+}
+
 size_t
 UdpChannel::size() const
 {
@@ -94,7 +186,8 @@ UdpChannel::size() const
 }
 
 std::pair<bool, shared_ptr<UdpFace>>
-UdpChannel::createFace(const udp::Endpoint& remoteEndpoint, ndn::nfd::FacePersistency persistency)
+UdpChannel::createFace(const udp::Endpoint& remoteEndpoint, ndn::nfd::FacePersistency persistency,
+                       size_t socketIndex)
 {
   auto it = m_channelFaces.find(remoteEndpoint);
   if (it != m_channelFaces.end()) {
@@ -111,13 +204,27 @@ UdpChannel::createFace(const udp::Endpoint& remoteEndpoint, ndn::nfd::FacePersis
   }
 
   // else, create a new face
-  ip::udp::socket socket(getGlobalIoService(), m_localEndpoint.protocol());
-  socket.set_option(ip::udp::socket::reuse_address(true));
-  socket.bind(m_localEndpoint);
-  socket.connect(remoteEndpoint);
+  shared_ptr<UdpFace> face;
+  if (m_wantSharedSocketFaces && persistency == ndn::nfd::FACE_PERSISTENCY_ON_DEMAND &&
+      isListening()) {
+    face = make_shared<UdpFace>(FaceUri(remoteEndpoint), FaceUri(m_localEndpoint),
+                                m_sockets[socketIndex], remoteEndpoint,
+                                persistency, m_idleFaceTimeout);
+  }
+  else {
+    ip::udp::socket socket(getGlobalIoService(), m_localEndpoint.protocol());
+    socket.set_option(ip::udp::socket::reuse_address(true));
+    if (m_nListenSockets > 1)
+      setReusePort(socket); // all sockets bound to a SO_REUSEPORT endpoint must have it
+    socket.bind(m_localEndpoint);
+    socket.connect(remoteEndpoint);
+
+    face = make_shared<UdpFace>(FaceUri(remoteEndpoint), FaceUri(m_localEndpoint),
+                                std::move(socket), persistency, m_idleFaceTimeout);
+  }
 
-  auto face = make_shared<UdpFace>(FaceUri(remoteEndpoint), FaceUri(m_localEndpoint),
-                                   std::move(socket), persistency, m_idleFaceTimeout);
+  if (m_maxAggregateSize > 0)
+    face->enableAggregation(m_maxAggregateSize, m_aggregationDelay);
 
   face->onFail.connectSingleShot([this, remoteEndpoint] (const std::string&) {
     NFD_LOG_TRACE("Erasing " << remoteEndpoint << " from channel face map");
@@ -125,12 +232,65 @@ UdpChannel::createFace(const udp::Endpoint& remoteEndpoint, ndn::nfd::FacePersis
   });
   m_channelFaces[remoteEndpoint] = face;
 
+  if (persistency == ndn::nfd::FACE_PERSISTENCY_ON_DEMAND)
+    scheduleCloseIdleFaces();
+
   return {true, face};
 }
 
+void
+UdpChannel::scheduleCloseIdleFaces()
+{
+  if (m_isCloseIdleFacesScheduled || m_idleFaceTimeout <= time::seconds::zero())
+    return;
+
+  m_isCloseIdleFacesScheduled = true;
+  m_closeIdleFacesEvent = scheduler::schedule(m_idleFaceTimeout,
+                                              bind(&UdpChannel::closeIdleFaces, this));
+}
+
+void
+UdpChannel::closeIdleFaces()
+{
+  m_isCloseIdleFacesScheduled = false;
+
+  // closing a face erases it from m_channelFaces, so collect idle faces first
+  std::vector<shared_ptr<UdpFace>> idleFaces;
+  bool hasOnDemandFaces = false;
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  for (const auto& entry : m_channelFaces) {
+    const shared_ptr<UdpFace>& face = entry.second;
+    if (face->isIdle(now))
+      idleFaces.push_back(face);
+    else if (face->getPersistency() == ndn::nfd::FACE_PERSISTENCY_ON_DEMAND)
+      hasOnDemandFaces = true;
+  }
+
+  if (!idleFaces.empty()) {
+    NFD_LOG_DEBUG("[" << m_localEndpoint << "] Closing " << idleFaces.size()
+                  << " faces for inactivity");
+  }
+  for (const auto& face : idleFaces)
+    face->close();
+
+  if (hasOnDemandFaces)
+    scheduleCloseIdleFaces();
+}
+
+void
+UdpChannel::startReceive(size_t socketIndex,
+                         const FaceCreatedCallback& onFaceCreated,
+                         const ConnectFailedCallback& onReceiveFailed)
+{
+  m_sockets[socketIndex].async_receive(boost::asio::null_buffers(),
+                                       bind(&UdpChannel::handleNewPeer, this,
+                                            boost::asio::placeholders::error, socketIndex,
+                                            onFaceCreated, onReceiveFailed));
+}
+
 void
 UdpChannel::handleNewPeer(const boost::system::error_code& error,
-                          size_t nBytesReceived,
+                          size_t socketIndex,
                           const FaceCreatedCallback& onFaceCreated,
                           const ConnectFailedCallback& onReceiveFailed)
 {
@@ -144,33 +304,43 @@ UdpChannel::handleNewPeer(const boost::system::error_code& error,
     return;
   }
 
-  NFD_LOG_DEBUG("[" << m_localEndpoint << "] New peer " << m_remoteEndpoint);
-
-  bool created;
-  shared_ptr<UdpFace> face;
-  try {
-    std::tie(created, face) = createFace(m_remoteEndpoint, ndn::nfd::FACE_PERSISTENCY_ON_DEMAND);
-  }
-  catch (const boost::system::system_error& e) {
-    NFD_LOG_WARN("[" << m_localEndpoint << "] Failed to create face for peer "
-                 << m_remoteEndpoint << ": " << e.what());
+  DatagramBatch& batch = getGlobalDatagramBatch();
+  boost::system::error_code receiveError;
+  size_t nReceived = batch.receive(m_sockets[socketIndex].native_handle(), receiveError);
+  if (receiveError) {
+    NFD_LOG_DEBUG("[" << m_localEndpoint << "] Receive failed: " << receiveError.message());
     if (onReceiveFailed)
-      onReceiveFailed(e.what());
+      onReceiveFailed(receiveError.message());
     return;
   }
 
-  if (created)
-    onFaceCreated(face);
+  for (size_t i = 0; i < nReceived; ++i) {
+    udp::Endpoint remoteEndpoint = batch.getSource<udp::Endpoint>(i);
+
+    bool created;
+    shared_ptr<UdpFace> face;
+    try {
+      std::tie(created, face) = createFace(remoteEndpoint, ndn::nfd::FACE_PERSISTENCY_ON_DEMAND,
+                                           socketIndex);
+    }
+    catch (const boost::system::system_error& e) {
+      NFD_LOG_WARN("[" << m_localEndpoint << "] Failed to create face for peer "
+                   << remoteEndpoint << ": " << e.what());
+      if (onReceiveFailed)
+        onReceiveFailed(e.what());
+      return;
+    }
+
+    if (created) {
+      NFD_LOG_DEBUG("[" << m_localEndpoint << "] New peer " << remoteEndpoint);
+      onFaceCreated(face);
+    }
 
-  // dispatch the datagram to the face for processing
-  face->receiveDatagram(m_inputBuffer, nBytesReceived, error);
+    // dispatch the datagram to the face for processing
+    face->receiveDatagram(batch.getDatagram(i), batch.getDatagramSize(i), receiveError);
+  }
 
-  m_socket.async_receive_from(boost::asio::buffer(m_inputBuffer, ndn::MAX_NDN_PACKET_SIZE),
-                              m_remoteEndpoint,
-                              bind(&UdpChannel::handleNewPeer, this,
-                                   boost::asio::placeholders::error,
-                                   boost::asio::placeholders::bytes_transferred,
-                                   onFaceCreated, onReceiveFailed));
+  startReceive(socketIndex, onFaceCreated, onReceiveFailed);
 }
 
 } // namespace nfd
@@ -27,11 +27,21 @@
 #define NFD_DAEMON_FACE_UDP_CHANNEL_HPP
 
 #include "channel.hpp"
+#include "core/scheduler.hpp"
 
 namespace nfd {
 
 namespace udp {
 typedef boost::asio::ip::udp::endpoint Endpoint;
+
+/**
+ * \brief Hash function for using udp::Endpoint as a key of unordered containers
+ */
+struct EndpointHash
+{
+  size_t
+  operator()(const Endpoint& endpoint) const;
+};
 } // namespace udp
 
 class UdpFace;
@@ -50,10 +60,16 @@ public:
    * The created socket is bound to the localEndpoint.
    * reuse_address option is set
    *
+   * If nListenSockets is greater than one, that many sockets are bound to the
+   * localEndpoint with the SO_REUSEPORT option, and the kernel spreads new peers
+   * among them by flow hash. This is supported only on platforms with SO_REUSEPORT;
+   * elsewhere, a single socket is used.
+   *
    * \throw UdpChannel::Error if bind on the socket fails
    */
   UdpChannel(const udp::Endpoint& localEndpoint,
-             const time::seconds& timeout);
+             const time::seconds& timeout,
+             size_t nListenSockets = 1);
 
   /**
    * \brief Enable listening on the local endpoint, accept connections,
@@ -61,9 +77,8 @@ public:
    * \param onFaceCreated  Callback to notify successful creation of the face
    * \param onAcceptFailed Callback to notify when channel fails
    *
-   * Once a face is created, if it doesn't send/receive anything for
+   * Once a face is created, if it doesn't receive anything for
    * a period of time equal to timeout, it will be destroyed
-   * \todo this functionality has to be implemented
    *
    * \throws UdpChannel::Error if called multiple times
    */
@@ -82,6 +97,25 @@ public:
           const FaceCreatedCallback& onFaceCreated,
           const ConnectFailedCallback& onConnectFailed);
 
+  /**
+   * \brief Make on-demand faces share the listen sockets of the channel
+   *
+   * By default, each face opens its own socket connected to the remote endpoint.
+   * When enabled, on-demand faces created afterwards send with send_to on the listen
+   * socket that received their first packet, and the channel dispatches incoming
+   * packets to them, so the number of file descriptors does not grow with the
+   * number of peers.
+   */
+  void
+  enableSharedSocketFaces();
+
+  /**
+   * \brief Enable packet aggregation on faces created afterwards
+   * \sa DatagramFace::enableAggregation
+   */
+  void
+  enableAggregation(size_t maxDatagramSize, const time::microseconds& flushDelay);
+
   /**
    * \brief Get number of faces in the channel
    */
@@ -92,46 +126,88 @@ public:
   isListening() const;
 
 private:
+  /**
+   * \brief Find or create the face for a remote endpoint
+   * \param socketIndex listen socket shared by a new on-demand face, if enabled
+   */
   std::pair<bool, shared_ptr<UdpFace>>
-  createFace(const udp::Endpoint& remoteEndpoint, ndn::nfd::FacePersistency persistency);
+  createFace(const udp::Endpoint& remoteEndpoint, ndn::nfd::FacePersistency persistency,
+             size_t socketIndex = 0);
 
   /**
-   * \brief The channel has received a new packet from a remote
-   *        endpoint that is not associated with any UdpFace yet
+   * \brief Wait for packets from remote endpoints that are not associated
+   *        with any UdpFace yet
+   */
+  void
+  startReceive(size_t socketIndex,
+               const FaceCreatedCallback& onFaceCreated,
+               const ConnectFailedCallback& onReceiveFailed);
+
+  /**
+   * \brief The channel has received new packets from remote
+   *        endpoints that are not associated with any UdpFace yet
+   *
+   * Packets are received in a batch, and each packet is dispatched
+   * to the face of its source endpoint.
    */
   void
   handleNewPeer(const boost::system::error_code& error,
-                size_t nBytesReceived,
+                size_t socketIndex,
                 const FaceCreatedCallback& onFaceCreated,
                 const ConnectFailedCallback& onReceiveFailed);
 
+  /**
+   * \brief Schedule closeIdleFaces, unless it is already scheduled
+   */
+  void
+  scheduleCloseIdleFaces();
+
+  /**
+   * \brief Close all on-demand faces that have been idle for the idle timeout
+   *
+   * A single periodic sweep replaces a timer per face. Each face only records
+   * when it was last used, so an idle face is closed between one and two
+   * timeouts after its last incoming packet.
+   */
+  void
+  closeIdleFaces();
+
 private:
-  std::map<udp::Endpoint, shared_ptr<UdpFace>> m_channelFaces;
+  std::unordered_map<udp::Endpoint, shared_ptr<UdpFace>, udp::EndpointHash> m_channelFaces;
 
   udp::Endpoint m_localEndpoint;
 
   /**
-   * \brief The latest peer that started communicating with us
+   * \brief Sockets used to "accept" new communication
    */
-  udp::Endpoint m_remoteEndpoint;
+  std::vector<boost::asio::ip::udp::socket> m_sockets;
 
   /**
-   * \brief Socket used to "accept" new communication
+   * \brief Number of sockets opened by listen
    */
-  boost::asio::ip::udp::socket m_socket;
+  size_t m_nListenSockets;
 
   /**
    * \brief When this timeout expires, all idle on-demand faces will be closed
    */
   time::seconds m_idleFaceTimeout;
 
-  uint8_t m_inputBuffer[ndn::MAX_NDN_PACKET_SIZE];
+  /**
+   * \brief Aggregation settings of new faces, disabled if m_maxAggregateSize is zero
+   */
+  size_t m_maxAggregateSize;
+  time::microseconds m_aggregationDelay;
+
+  bool m_wantSharedSocketFaces;
+
+  scheduler::ScopedEventId m_closeIdleFacesEvent;
+  bool m_isCloseIdleFacesScheduled;
 };
 
 inline bool
 UdpChannel::isListening() const
 {
-  return m_socket.is_open();
+  return !m_sockets.empty() && m_sockets.front().is_open();
 }
 
 } // namespace nfd
@@ -24,7 +24,6 @@
  */
 
 #include "udp-face.hpp"
-// #include "core/global-io.hpp" // for #1718 manual test below
 
 #ifdef __linux__
 #include <cerrno>       // for errno
@@ -42,7 +41,6 @@ UdpFace::UdpFace(const FaceUri& remoteUri, const FaceUri& localUri,
                  const time::seconds& idleTimeout)
   : DatagramFace(remoteUri, localUri, std::move(socket))
   , m_idleTimeout(idleTimeout)
-  , m_lastIdleCheck(time::steady_clock::now())
 {
   this->setPersistency(persistency);
 
@@ -65,10 +63,15 @@ UdpFace::UdpFace(const FaceUri& remoteUri, const FaceUri& localUri,
     NFD_LOG_FACE_WARN("Failed to disable path MTU discovery: " << std::strerror(errno));
   }
 #endif
+}
 
-  if (this->getPersistency() == ndn::nfd::FACE_PERSISTENCY_ON_DEMAND && m_idleTimeout > time::seconds::zero()) {
-    m_closeIfIdleEvent = scheduler::schedule(m_idleTimeout, bind(&UdpFace::closeIfIdle, this));
-  }
+UdpFace::UdpFace(const FaceUri& remoteUri, const FaceUri& localUri,
+                 protocol::socket& sharedSocket, const protocol::endpoint& remoteEndpoint,
+                 ndn::nfd::FacePersistency persistency, const time::seconds& idleTimeout)
+  : DatagramFace(remoteUri, localUri, sharedSocket, remoteEndpoint)
+  , m_idleTimeout(idleTimeout)
+{
+  this->setPersistency(persistency);
 }
 
 ndn::nfd::FaceStatus
@@ -78,44 +81,25 @@ UdpFace::getFaceStatus() const
 
   if (this->getPersistency() == ndn::nfd::FACE_PERSISTENCY_ON_DEMAND) {
     time::milliseconds left = m_idleTimeout;
-    left -= time::duration_cast<time::milliseconds>(time::steady_clock::now() - m_lastIdleCheck);
+    left -= time::duration_cast<time::milliseconds>(time::steady_clock::now() - getLastUsedTime());
 
     if (left < time::milliseconds::zero())
       left = time::milliseconds::zero();
 
-    if (hasBeenUsedRecently())
-      left += m_idleTimeout;
-
     status.setExpirationPeriod(left);
   }
 
   return status;
 }
 
-void
-UdpFace::closeIfIdle()
+bool
+UdpFace::isIdle(const time::steady_clock::TimePoint& now) const
 {
   // Face can be switched from on-demand to non-on-demand mode
   // (non-on-demand -> on-demand transition is not allowed)
-  if (this->getPersistency() == ndn::nfd::FACE_PERSISTENCY_ON_DEMAND) {
-    if (!hasBeenUsedRecently()) {
-      NFD_LOG_FACE_INFO("Closing for inactivity");
-      close();
-
-      // #1718 manual test: uncomment, run NFD in valgrind, send in a UDP packet
-      //                    expect read-after-free error and crash
-      // getGlobalIoService().post([this] {
-      //   NFD_LOG_FACE_ERROR("Remaining references: " << this->shared_from_this().use_count());
-      // });
-    }
-    else {
-      resetRecentUsage();
-
-      m_lastIdleCheck = time::steady_clock::now();
-      m_closeIfIdleEvent = scheduler::schedule(m_idleTimeout, bind(&UdpFace::closeIfIdle, this));
-    }
-  }
-  // else do nothing and do not reschedule the event
+  return this->getPersistency() == ndn::nfd::FACE_PERSISTENCY_ON_DEMAND &&
+         m_idleTimeout > time::seconds::zero() &&
+         now - getLastUsedTime() >= m_idleTimeout;
 }
 
 } // namespace nfd
@@ -27,7 +27,6 @@
 #define NFD_DAEMON_FACE_UDP_FACE_HPP
 
 #include "datagram-face.hpp"
-#include "core/scheduler.hpp"
 
 namespace nfd {
 
@@ -42,17 +41,27 @@ public:
           protocol::socket socket, ndn::nfd::FacePersistency persistency,
           const time::seconds& idleTimeout);
 
+  /** \brief Creates a face that sends and receives through a socket shared with other faces
+   *
+   *  The socket should have path MTU discovery disabled, see the other constructor.
+   *  The channel that owns the socket passes incoming datagrams to receiveDatagram.
+   */
+  UdpFace(const FaceUri& remoteUri, const FaceUri& localUri,
+          protocol::socket& sharedSocket, const protocol::endpoint& remoteEndpoint,
+          ndn::nfd::FacePersistency persistency, const time::seconds& idleTimeout);
+
   ndn::nfd::FaceStatus
   getFaceStatus() const DECL_OVERRIDE;
 
-private:
-  void
-  closeIfIdle();
+  /** \brief determines whether an on-demand face has been idle for the idle timeout
+   *
+   *  Idle faces are closed by UdpChannel, which checks all its faces periodically.
+   */
+  bool
+  isIdle(const time::steady_clock::TimePoint& now) const;
 
 private:
   const time::seconds m_idleTimeout;
-  time::steady_clock::TimePoint m_lastIdleCheck;
-  scheduler::ScopedEventId m_closeIfIdleEvent;
 
   // friend because it needs to invoke protected Face::setOnDemand
   friend class UdpChannel;
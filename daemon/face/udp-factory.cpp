@@ -109,7 +109,8 @@ UdpFactory::prohibitAllIpv6Endpoints(const uint16_t port)
 
 shared_ptr<UdpChannel>
 UdpFactory::createChannel(const udp::Endpoint& endpoint,
-                          const time::seconds& timeout)
+                          const time::seconds& timeout,
+                          size_t nListenSockets)
 {
   NFD_LOG_DEBUG("Creating unicast channel " << endpoint);
 
@@ -129,7 +130,7 @@ UdpFactory::createChannel(const udp::Endpoint& endpoint,
                                 "create a multicast face"));
   }
 
-  channel = make_shared<UdpChannel>(endpoint, timeout);
+  channel = make_shared<UdpChannel>(endpoint, timeout, nListenSockets);
   m_channels[endpoint] = channel;
   prohibitEndpoint(endpoint);
 
@@ -139,11 +140,12 @@ UdpFactory::createChannel(const udp::Endpoint& endpoint,
 shared_ptr<UdpChannel>
 UdpFactory::createChannel(const std::string& localIp,
                           const std::string& localPort,
-                          const time::seconds& timeout)
+                          const time::seconds& timeout,
+                          size_t nListenSockets)
 {
   using namespace boost::asio::ip;
   udp::Endpoint endpoint(address::from_string(localIp), boost::lexical_cast<uint16_t>(localPort));
-  return createChannel(endpoint, timeout);
+  return createChannel(endpoint, timeout, nListenSockets);
 }
 
 shared_ptr<MulticastUdpFace>
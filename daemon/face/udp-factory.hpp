@@ -71,6 +71,9 @@ public:
    * a period of time equal to timeout, it will be destroyed
    * @todo this funcionality has to be implemented
    *
+   * If nListenSockets is greater than one, the channel listens on that many
+   * SO_REUSEPORT sockets bound to the same endpoint.
+   *
    * \returns always a valid pointer to a UdpChannel object, an exception
    *          is thrown if it cannot be created.
    *
@@ -81,7 +84,8 @@ public:
    */
   shared_ptr<UdpChannel>
   createChannel(const udp::Endpoint& localEndpoint,
-                const time::seconds& timeout = time::seconds(600));
+                const time::seconds& timeout = time::seconds(600),
+                size_t nListenSockets = 1);
 
   /**
    * \brief Create UDP-based channel using specified IP address and port number
@@ -100,7 +104,8 @@ public:
   shared_ptr<UdpChannel>
   createChannel(const std::string& localIp,
                 const std::string& localPort,
-                const time::seconds& timeout = time::seconds(600));
+                const time::seconds& timeout = time::seconds(600),
+                size_t nListenSockets = 1);
 
   /**
    * \brief Create MulticastUdpFace using udp::Endpoint
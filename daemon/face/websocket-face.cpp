@@ -53,6 +53,8 @@ WebSocketFace::sendInterest(const Interest& interest)
 
   const Block& payload = interest.wireEncode();
   this->getMutableCounters().getNOutBytes() += payload.size();
+  // websocketpp copies the payload into a message buffer
+  this->getMutableCounters().getNOutBytesCopied() += payload.size();
 
   websocketpp::lib::error_code ec;
   m_server.send(m_handle, payload.wire(), payload.size(),
@@ -73,6 +75,8 @@ WebSocketFace::sendData(const Data& data)
 
   const Block& payload = data.wireEncode();
   this->getMutableCounters().getNOutBytes() += payload.size();
+  // websocketpp copies the payload into a message buffer
+  this->getMutableCounters().getNOutBytesCopied() += payload.size();
 
   websocketpp::lib::error_code ec;
   m_server.send(m_handle, payload.wire(), payload.size(),
@@ -175,7 +175,7 @@ AccessStrategy::multicast(shared_ptr<pit::Entry> pitEntry, shared_ptr<fib::Entry
                           std::unordered_set<FaceId> exceptFaces)
 {
   for (const fib::NextHop& nexthop : fibEntry->getNextHops()) {
-    shared_ptr<Face> face = nexthop.getFace();
+    shared_ptr<Face> face = nexthop.getFace().shared_from_this();
     if (exceptFaces.count(face->getId()) > 0) {
       continue;
     }
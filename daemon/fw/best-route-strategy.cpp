@@ -41,10 +41,10 @@ BestRouteStrategy::~BestRouteStrategy()
 }
 
 static inline bool
-predicate_PitEntry_canForwardTo_NextHop(shared_ptr<pit::Entry> pitEntry,
+predicate_PitEntry_canForwardTo_NextHop(const shared_ptr<pit::Entry>& pitEntry,
                                         const fib::NextHop& nexthop)
 {
-  return pitEntry->canForwardTo(*nexthop.getFace());
+  return pitEntry->canForwardTo(nexthop.getFace());
 }
 
 void
@@ -60,14 +60,14 @@ BestRouteStrategy::afterReceiveInterest(const Face& inFace,
 
   const fib::NextHopList& nexthops = fibEntry->getNextHops();
   fib::NextHopList::const_iterator it = std::find_if(nexthops.begin(), nexthops.end(),
-    bind(&predicate_PitEntry_canForwardTo_NextHop, pitEntry, _1));
+    bind(&predicate_PitEntry_canForwardTo_NextHop, cref(pitEntry), _1));
 
   if (it == nexthops.end()) {
     this->rejectPendingInterest(pitEntry);
     return;
   }
 
-  shared_ptr<Face> outFace = it->getFace();
+  shared_ptr<Face> outFace = it->getFace().shared_from_this();
   this->sendInterest(pitEntry, outFace);
 }
 
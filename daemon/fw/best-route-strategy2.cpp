@@ -50,19 +50,19 @@ predicate_NextHop_eligible(const shared_ptr<pit::Entry>& pitEntry,
   bool wantUnused = false,
   time::steady_clock::TimePoint now = time::steady_clock::TimePoint::min())
 {
-  shared_ptr<Face> upstream = nexthop.getFace();
+  const Face& upstream = nexthop.getFace();
 
   // upstream is current downstream
-  if (upstream->getId() == currentDownstream)
+  if (upstream.getId() == currentDownstream)
     return false;
 
   // forwarding would violate scope
-  if (pitEntry->violatesScope(*upstream))
+  if (pitEntry->violatesScope(upstream))
     return false;
 
   if (wantUnused) {
     // NextHop must not have unexpired OutRecord
-    pit::OutRecordCollection::const_iterator outRecord = pitEntry->getOutRecord(*upstream);
+    pit::OutRecordCollection::const_iterator outRecord = pitEntry->getOutRecord(upstream);
     if (outRecord != pitEntry->getOutRecords().end() &&
         outRecord->getExpiry() > now) {
       return false;
@@ -85,7 +85,7 @@ findEligibleNextHopWithEarliestOutRecord(const shared_ptr<pit::Entry>& pitEntry,
   for (fib::NextHopList::const_iterator it = nexthops.begin(); it != nexthops.end(); ++it) {
     if (!predicate_NextHop_eligible(pitEntry, *it, currentDownstream))
       continue;
-    pit::OutRecordCollection::const_iterator outRecord = pitEntry->getOutRecord(*it->getFace());
+    pit::OutRecordCollection::const_iterator outRecord = pitEntry->getOutRecord(it->getFace());
     BOOST_ASSERT(outRecord != pitEntry->getOutRecords().end());
     if (outRecord->getLastRenewed() < earliestRenewed) {
       found = it;
@@ -109,7 +109,7 @@ BestRouteStrategy2::afterReceiveInterest(const Face& inFace,
   if (suppression == RetxSuppression::NEW) {
     // forward to nexthop with lowest cost except downstream
     it = std::find_if(nexthops.begin(), nexthops.end(),
-      bind(&predicate_NextHop_eligible, pitEntry, _1, inFace.getId(),
+      bind(&predicate_NextHop_eligible, cref(pitEntry), _1, inFace.getId(),
            false, time::steady_clock::TimePoint::min()));
 
     if (it == nexthops.end()) {
@@ -118,7 +118,7 @@ BestRouteStrategy2::afterReceiveInterest(const Face& inFace,
       return;
     }
 
-    shared_ptr<Face> outFace = it->getFace();
+    shared_ptr<Face> outFace = it->getFace().shared_from_this();
     this->sendInterest(pitEntry, outFace);
     NFD_LOG_DEBUG(interest << " from=" << inFace.getId()
                            << " newPitEntry-to=" << outFace->getId());
@@ -133,10 +133,10 @@ BestRouteStrategy2::afterReceiveInterest(const Face& inFace,
 
   // find an unused upstream with lowest cost except downstream
   it = std::find_if(nexthops.begin(), nexthops.end(),
-                    bind(&predicate_NextHop_eligible, pitEntry, _1, inFace.getId(),
+                    bind(&predicate_NextHop_eligible, cref(pitEntry), _1, inFace.getId(),
                          true, time::steady_clock::now()));
   if (it != nexthops.end()) {
-    shared_ptr<Face> outFace = it->getFace();
+    shared_ptr<Face> outFace = it->getFace().shared_from_this();
     this->sendInterest(pitEntry, outFace);
     NFD_LOG_DEBUG(interest << " from=" << inFace.getId()
                            << " retransmit-unused-to=" << outFace->getId());
@@ -149,7 +149,7 @@ BestRouteStrategy2::afterReceiveInterest(const Face& inFace,
     NFD_LOG_DEBUG(interest << " from=" << inFace.getId() << " retransmitNoNextHop");
   }
   else {
-    shared_ptr<Face> outFace = it->getFace();
+    shared_ptr<Face> outFace = it->getFace().shared_from_this();
     this->sendInterest(pitEntry, outFace);
     NFD_LOG_DEBUG(interest << " from=" << inFace.getId()
                            << " retransmit-retry-to=" << outFace->getId());
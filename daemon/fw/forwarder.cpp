@@ -40,6 +40,8 @@ NFD_LOG_INIT("Forwarder");
 using fw::Strategy;
 
 const Name Forwarder::LOCALHOST_NAME("ndn:/localhost");
+const time::nanoseconds Forwarder::DEFAULT_STRAGGLER_DURATION = time::milliseconds(100);
+const time::nanoseconds Forwarder::STRAGGLER_DRAIN_INTERVAL = time::milliseconds(10);
 
 Forwarder::Forwarder()
   : m_faceTable(*this)
@@ -48,6 +50,10 @@ Forwarder::Forwarder()
   , m_measurements(m_nameTree)
   , m_strategyChoice(m_nameTree, fw::makeDefaultStrategy(*this))
   , m_csFace(make_shared<NullFace>(FaceUri("contentstore://")))
+  , m_lastStragglerSeq(0)
+  , m_stragglerDuration(DEFAULT_STRAGGLER_DURATION)
+  , m_isStragglerQueueSorted(true)
+  , m_stragglerUnsortedUntil(time::steady_clock::TimePoint::min())
 {
   fw::installStrategies(*this);
   getFaceTable().addReserved(m_csFace, FACEID_CONTENT_STORE);
@@ -81,9 +87,10 @@ Forwarder::onIncomingInterest(Face& inFace, const Interest& interest)
   shared_ptr<pit::Entry> pitEntry = m_pit.insert(interest).first;
 
   // detect duplicate Nonce
-  int dnw = pitEntry->findNonce(interest.getNonce(), inFace);
+  uint32_t nonce = interest.getNonce();
+  int dnw = pitEntry->findNonce(nonce, inFace);
   bool hasDuplicateNonce = (dnw != pit::DUPLICATE_NONCE_NONE) ||
-                           m_deadNonceList.has(interest.getName(), interest.getNonce());
+                           m_deadNonceList.has(interest.getName(), nonce);
   if (hasDuplicateNonce) {
     // goto Interest loop pipeline
     this->onInterestLoop(inFace, interest, pitEntry);
@@ -438,22 +445,91 @@ Forwarder::setUnsatisfyTimer(shared_ptr<pit::Entry> pitEntry)
     bind(&Forwarder::onInterestUnsatisfied, this, pitEntry));
 }
 
+void
+Forwarder::setStragglerDuration(const time::nanoseconds& duration)
+{
+  if (duration < m_stragglerDuration && !m_stragglers.empty()) {
+    // records appended from now on may expire before records already queued;
+    // if the queue is sorted, its last record expires last
+    if (m_isStragglerQueueSorted) {
+      m_stragglerUnsortedUntil = m_stragglers.back().expiry;
+    }
+    else {
+      m_stragglerUnsortedUntil = std::max(m_stragglerUnsortedUntil, m_stragglers.back().expiry);
+    }
+    m_isStragglerQueueSorted = false;
+    m_stragglerDrainEvent = scheduler::schedule(std::max(duration, STRAGGLER_DRAIN_INTERVAL),
+                                                bind(&Forwarder::drainStragglers, this));
+  }
+  m_stragglerDuration = duration;
+}
+
 void
 Forwarder::setStragglerTimer(shared_ptr<pit::Entry> pitEntry, bool isSatisfied,
                              const time::milliseconds& dataFreshnessPeriod)
 {
-  time::nanoseconds stragglerTime = time::milliseconds(100);
+  pitEntry->m_stragglerSeq = ++m_lastStragglerSeq;
+
+  bool wasEmpty = m_stragglers.empty();
+  m_stragglers.push_back({time::steady_clock::now() + m_stragglerDuration, pitEntry,
+                          pitEntry->m_stragglerSeq, isSatisfied, dataFreshnessPeriod});
 
-  scheduler::cancel(pitEntry->m_stragglerTimer);
-  pitEntry->m_stragglerTimer = scheduler::schedule(stragglerTime,
-    bind(&Forwarder::onInterestFinalize, this, pitEntry, isSatisfied, dataFreshnessPeriod));
+  if (wasEmpty) {
+    m_stragglerDrainEvent = scheduler::schedule(m_stragglerDuration,
+                                                bind(&Forwarder::drainStragglers, this));
+  }
 }
 
 void
 Forwarder::cancelUnsatisfyAndStragglerTimer(shared_ptr<pit::Entry> pitEntry)
 {
   scheduler::cancel(pitEntry->m_unsatisfyTimer);
-  scheduler::cancel(pitEntry->m_stragglerTimer);
+  pitEntry->m_stragglerSeq = 0;
+}
+
+void
+Forwarder::drainStragglers()
+{
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  time::steady_clock::TimePoint nextExpiry = time::steady_clock::TimePoint::max();
+
+  if (m_isStragglerQueueSorted) {
+    while (!m_stragglers.empty() && m_stragglers.front().expiry <= now) {
+      StragglerRecord record = std::move(m_stragglers.front());
+      m_stragglers.pop_front();
+
+      if (record.seq == record.pitEntry->m_stragglerSeq) {
+        this->onInterestFinalize(record.pitEntry, record.isSatisfied, record.dataFreshnessPeriod);
+      }
+    }
+
+    if (!m_stragglers.empty())
+      nextExpiry = m_stragglers.front().expiry;
+  }
+  else {
+    // expired records can be anywhere in the queue
+    std::deque<StragglerRecord> records;
+    records.swap(m_stragglers);
+    for (StragglerRecord& record : records) {
+      if (record.expiry > now) {
+        nextExpiry = std::min(nextExpiry, record.expiry);
+        m_stragglers.push_back(std::move(record));
+      }
+      else if (record.seq == record.pitEntry->m_stragglerSeq) {
+        this->onInterestFinalize(record.pitEntry, record.isSatisfied, record.dataFreshnessPeriod);
+      }
+    }
+
+    // once records queued before the duration change are gone, the rest is in expiry order
+    m_isStragglerQueueSorted = m_stragglers.empty() || now >= m_stragglerUnsortedUntil;
+  }
+
+  if (!m_stragglers.empty()) {
+    time::nanoseconds nextDrain = std::max<time::nanoseconds>(nextExpiry - now,
+                                                              STRAGGLER_DRAIN_INTERVAL);
+    m_stragglerDrainEvent = scheduler::schedule(nextDrain,
+                                                bind(&Forwarder::drainStragglers, this));
+  }
 }
 
 static inline void
@@ -112,6 +112,19 @@ public: // allow enabling ndnSIM content store (will be removed in the future)
   void
   setCsFromNdnSim(ns3::Ptr<ns3::ndn::ContentStore> cs);
 
+public: // PIT straggler
+  /** \brief set how long a PIT entry is retained after it's satisfied or unsatisfied
+   *
+   *  This affects PIT entries entering straggler state after this call.
+   */
+  void
+  setStragglerDuration(const time::nanoseconds& duration);
+
+  const time::nanoseconds&
+  getStragglerDuration() const;
+
+  static const time::nanoseconds DEFAULT_STRAGGLER_DURATION;
+
 public:
   /** \brief trigger before PIT entry is satisfied
    *  \sa Strategy::beforeSatisfyInterest
@@ -196,6 +209,11 @@ PROTECTED_WITH_TESTS_ELSE_PRIVATE:
   VIRTUAL_WITH_TESTS void
   cancelUnsatisfyAndStragglerTimer(shared_ptr<pit::Entry> pitEntry);
 
+  /** \brief finalize PIT entries whose straggler duration has elapsed
+   */
+  void
+  drainStragglers();
+
   /** \brief insert Nonce to Dead Nonce List if necessary
    *  \param upstream if null, insert Nonces from all OutRecords;
    *                  if not null, insert Nonce only on the OutRecord of this face
@@ -232,8 +250,51 @@ private:
 
   ns3::Ptr<ns3::ndn::ContentStore> m_csFromNdnSim;
 
+  /** \brief a PIT entry waiting for straggler expiry
+   */
+  struct StragglerRecord
+  {
+    time::steady_clock::TimePoint expiry;
+    shared_ptr<pit::Entry> pitEntry;
+    uint64_t seq; ///< record is stale unless this equals pitEntry->m_stragglerSeq
+    bool isSatisfied;
+    time::milliseconds dataFreshnessPeriod;
+  };
+
+  /** \brief straggler queue
+   *
+   *  While the straggler duration is constant, records are appended in expiry order,
+   *  and a single drain event replaces per-entry straggler timers.
+   *  Cancelling a straggler timer leaves a stale record in the queue.
+   */
+  std::deque<StragglerRecord> m_stragglers;
+  uint64_t m_lastStragglerSeq;
+  time::nanoseconds m_stragglerDuration;
+  scheduler::ScopedEventId m_stragglerDrainEvent;
+
+PROTECTED_WITH_TESTS_ELSE_PRIVATE:
+  /** \brief whether m_stragglers is in expiry order
+   *
+   *  This is false after the straggler duration is shortened while records are queued,
+   *  until every record queued before that has expired. Drains then look at every record.
+   */
+  bool m_isStragglerQueueSorted;
+
+  /** \brief latest expiry of records queued before the straggler duration was shortened
+   *
+   *  Records appended afterwards are in expiry order among themselves,
+   *  so the queue is sorted again once this has passed.
+   */
+  time::steady_clock::TimePoint m_stragglerUnsortedUntil;
+
+private:
+
   static const Name LOCALHOST_NAME;
 
+  /** \brief minimum interval between drain events, so that expiries are coalesced
+   */
+  static const time::nanoseconds STRAGGLER_DRAIN_INTERVAL;
+
   // allow Strategy (base class) to enter pipelines
   friend class fw::Strategy;
 };
@@ -322,6 +383,12 @@ Forwarder::setCsFromNdnSim(ns3::Ptr<ns3::ndn::ContentStore> cs)
   m_csFromNdnSim = cs;
 }
 
+inline const time::nanoseconds&
+Forwarder::getStragglerDuration() const
+{
+  return m_stragglerDuration;
+}
+
 #ifdef WITH_TESTS
 inline void
 Forwarder::dispatchToStrategy(shared_ptr<pit::Entry> pitEntry, function<void(fw::Strategy*)> trigger)
@@ -45,7 +45,7 @@ MulticastStrategy::afterReceiveInterest(const Face& inFace,
   const fib::NextHopList& nexthops = fibEntry->getNextHops();
 
   for (fib::NextHopList::const_iterator it = nexthops.begin(); it != nexthops.end(); ++it) {
-    shared_ptr<Face> outFace = it->getFace();
+    shared_ptr<Face> outFace = it->getFace().shared_from_this();
     if (pitEntry->canForwardTo(*outFace)) {
       this->sendInterest(pitEntry, outFace);
     }
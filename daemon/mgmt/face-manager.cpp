@@ -27,7 +27,9 @@
 
 #include "core/logger.hpp"
 #include "core/config-file.hpp"
+#include "core/network-interface.hpp"
 #include "face/protocol-factory.hpp"
+#include "face/udp-factory.hpp"
 #include "fw/face-table.hpp"
 
 #include <ndn-cxx/management/nfd-face-event-notification.hpp>
@@ -145,7 +147,304 @@ FaceManager::onConfig(const ConfigSection& configSection,
                       bool isDryRun,
                       const std::string& filename)
 {
-  BOOST_THROW_EXCEPTION(Error("Not supported"));
+  bool hasSeenUdp = false;
+
+  const std::vector<NetworkInterfaceInfo> nicList(listNetworkInterfaces());
+
+  for (const auto& item : configSection)
+    {
+      if (item.first == "udp")
+        {
+          if (hasSeenUdp)
+            BOOST_THROW_EXCEPTION(Error("Duplicate \"udp\" section"));
+          hasSeenUdp = true;
+
+          processSectionUdp(item.second, isDryRun, nicList);
+        }
+      else if (item.first == "unix" || item.first == "tcp" ||
+               item.first == "ether" || item.first == "websocket")
+        {
+          BOOST_THROW_EXCEPTION(Error("\"" + item.first + "\" section is not supported"));
+        }
+      else
+        {
+          BOOST_THROW_EXCEPTION(Error("Unrecognized option \"" + item.first + "\""));
+        }
+    }
+}
+
+void
+FaceManager::processSectionUdp(const ConfigSection& configSection,
+                               bool isDryRun,
+                               const std::vector<NetworkInterfaceInfo>& nicList)
+{
+  // ; the udp section contains settings of UDP faces and channels
+  // udp
+  // {
+  //   port 6363 ; UDP unicast port number
+  //   idle_timeout 600 ; idle time (seconds) before closing a UDP unicast face
+  //   keep_alive_interval 25; interval (seconds) between keep-alive refreshes
+  //   listen_sockets 1 ; number of SO_REUSEPORT sockets per unicast channel
+  //   aggregate_size 0 ; maximum size of an aggregate datagram, 0 disables aggregation
+  //   aggregate_delay 500 ; maximum time (microseconds) a packet waits to be aggregated
+  //   shared_socket_faces no ; on-demand faces send on the listen socket, default 'no'
+
+  //   ; NFD creates one UDP multicast face per NIC
+  //   mcast yes ; set to 'no' to disable UDP multicast, default 'yes'
+  //   mcast_port 56363 ; UDP multicast port number
+  //   mcast_group 224.0.23.170 ; UDP multicast group (IPv4 only)
+  // }
+
+  std::string port = "6363";
+  bool enableV4 = true;
+  bool enableV6 = true;
+  size_t timeout = 600;
+  size_t keepAliveInterval = 25;
+  size_t nListenSockets = 1;
+  size_t maxAggregateSize = 0;
+  size_t aggregationDelay = 500;
+  bool wantSharedSocketFaces = false;
+  bool useMcast = true;
+  std::string mcastGroup = "224.0.23.170";
+  std::string mcastPort = "56363";
+
+  for (ConfigSection::const_iterator i = configSection.begin();
+       i != configSection.end();
+       ++i)
+    {
+      if (i->first == "port")
+        {
+          port = i->second.get_value<std::string>();
+          try
+            {
+              uint16_t portNo = boost::lexical_cast<uint16_t>(port);
+              NFD_LOG_TRACE("UDP port set to " << portNo);
+            }
+          catch (const std::bad_cast& error)
+            {
+              BOOST_THROW_EXCEPTION(ConfigFile::Error("Invalid value for option \"" +
+                                                      i->first + "\" in \"udp\" section"));
+            }
+        }
+      else if (i->first == "enable_v4")
+        {
+          enableV4 = parseYesNo(i, i->first, "udp");
+        }
+      else if (i->first == "enable_v6")
+        {
+          enableV6 = parseYesNo(i, i->first, "udp");
+        }
+      else if (i->first == "idle_timeout")
+        {
+          try
+            {
+              timeout = i->second.get_value<size_t>();
+            }
+          catch (const std::exception& e)
+            {
+              BOOST_THROW_EXCEPTION(ConfigFile::Error("Invalid value for option \"" +
+                                                      i->first + "\" in \"udp\" section"));
+            }
+        }
+      else if (i->first == "keep_alive_interval")
+        {
+          try
+            {
+              keepAliveInterval = i->second.get_value<size_t>();
+
+              /// \todo Make use of keepAliveInterval
+              (void)(keepAliveInterval);
+            }
+          catch (const std::exception& e)
+            {
+              BOOST_THROW_EXCEPTION(ConfigFile::Error("Invalid value for option \"" +
+                                                      i->first + "\" in \"udp\" section"));
+            }
+        }
+      else if (i->first == "listen_sockets")
+        {
+          try
+            {
+              nListenSockets = i->second.get_value<size_t>();
+            }
+          catch (const std::exception& e)
+            {
+              nListenSockets = 0;
+            }
+          if (nListenSockets == 0)
+            {
+              BOOST_THROW_EXCEPTION(ConfigFile::Error("Invalid value for option \"" +
+                                                      i->first + "\" in \"udp\" section"));
+            }
+        }
+      else if (i->first == "aggregate_size")
+        {
+          try
+            {
+              maxAggregateSize = i->second.get_value<size_t>();
+            }
+          catch (const std::exception& e)
+            {
+              BOOST_THROW_EXCEPTION(ConfigFile::Error("Invalid value for option \"" +
+                                                      i->first + "\" in \"udp\" section"));
+            }
+          if (maxAggregateSize > ndn::MAX_NDN_PACKET_SIZE)
+            {
+              BOOST_THROW_EXCEPTION(ConfigFile::Error("Invalid value for option \"" +
+                                                      i->first + "\" in \"udp\" section"));
+            }
+        }
+      else if (i->first == "aggregate_delay")
+        {
+          try
+            {
+              aggregationDelay = i->second.get_value<size_t>();
+            }
+          catch (const std::exception& e)
+            {
+              BOOST_THROW_EXCEPTION(ConfigFile::Error("Invalid value for option \"" +
+                                                      i->first + "\" in \"udp\" section"));
+            }
+        }
+      else if (i->first == "shared_socket_faces")
+        {
+          wantSharedSocketFaces = parseYesNo(i, i->first, "udp");
+        }
+      else if (i->first == "mcast")
+        {
+          useMcast = parseYesNo(i, i->first, "udp");
+        }
+      else if (i->first == "mcast_port")
+        {
+          mcastPort = i->second.get_value<std::string>();
+          try
+            {
+              uint16_t portNo = boost::lexical_cast<uint16_t>(mcastPort);
+              NFD_LOG_TRACE("UDP multicast port set to " << portNo);
+            }
+          catch (const std::bad_cast& error)
+            {
+              BOOST_THROW_EXCEPTION(ConfigFile::Error("Invalid value for option \"" +
+                                                      i->first + "\" in \"udp\" section"));
+            }
+        }
+      else if (i->first == "mcast_group")
+        {
+          using namespace boost::asio::ip;
+          mcastGroup = i->second.get_value<std::string>();
+          try
+            {
+              address mcastGroupTest = address::from_string(mcastGroup);
+              if (!mcastGroupTest.is_v4())
+                {
+                  BOOST_THROW_EXCEPTION(ConfigFile::Error("Invalid value for option \"" +
+                                                          i->first + "\" in \"udp\" section"));
+                }
+            }
+          catch (const std::runtime_error& e)
+            {
+              BOOST_THROW_EXCEPTION(ConfigFile::Error("Invalid value for option \"" +
+                                                      i->first + "\" in \"udp\" section"));
+            }
+        }
+      else
+        {
+          BOOST_THROW_EXCEPTION(ConfigFile::Error("Unrecognized option \"" +
+                                                  i->first + "\" in \"udp\" section"));
+        }
+    }
+
+  if (!enableV4 && !enableV6)
+    {
+      BOOST_THROW_EXCEPTION(ConfigFile::Error("IPv4 and IPv6 channels have been disabled."
+                                              " Remove \"udp\" section to disable UDP channels or"
+                                              " re-enable at least one channel type."));
+    }
+  else if (useMcast && !enableV4)
+    {
+      BOOST_THROW_EXCEPTION(ConfigFile::Error("IPv4 multicast requested, but IPv4 channels"
+                                              " have been disabled (conflicting configuration"
+                                              " options set)"));
+    }
+
+  if (isDryRun)
+    return;
+
+  shared_ptr<UdpFactory> factory;
+  bool isReload = false;
+  if (m_factories.count("udp") > 0)
+    {
+      isReload = true;
+      factory = static_pointer_cast<UdpFactory>(m_factories["udp"]);
+    }
+  else
+    {
+      factory = make_shared<UdpFactory>(port);
+      m_factories.insert(std::make_pair("udp", factory));
+    }
+
+  if (!isReload && enableV4)
+    {
+      shared_ptr<UdpChannel> v4Channel =
+        factory->createChannel("0.0.0.0", port, time::seconds(timeout), nListenSockets);
+
+      if (maxAggregateSize > 0)
+        v4Channel->enableAggregation(maxAggregateSize, time::microseconds(aggregationDelay));
+      if (wantSharedSocketFaces)
+        v4Channel->enableSharedSocketFaces();
+      v4Channel->listen(bind(&FaceManager::addCreatedFaceToForwarder, this, _1), nullptr);
+
+      m_factories.insert(std::make_pair("udp4", factory));
+    }
+
+  if (!isReload && enableV6)
+    {
+      shared_ptr<UdpChannel> v6Channel =
+        factory->createChannel("::", port, time::seconds(timeout), nListenSockets);
+
+      if (maxAggregateSize > 0)
+        v6Channel->enableAggregation(maxAggregateSize, time::microseconds(aggregationDelay));
+      if (wantSharedSocketFaces)
+        v6Channel->enableSharedSocketFaces();
+      v6Channel->listen(bind(&FaceManager::addCreatedFaceToForwarder, this, _1), nullptr);
+
+      m_factories.insert(std::make_pair("udp6", factory));
+    }
+
+  std::list<shared_ptr<MulticastUdpFace>> multicastFacesToRemove;
+  for (const auto& multicastFace : factory->getMulticastFaces())
+    multicastFacesToRemove.push_back(multicastFace.second);
+
+  if (useMcast && enableV4)
+    {
+      std::vector<NetworkInterfaceInfo> ipv4MulticastInterfaces;
+      for (const auto& nic : nicList)
+        {
+          if (nic.isUp() && nic.isMulticastCapable() && !nic.ipv4Addresses.empty())
+            ipv4MulticastInterfaces.push_back(nic);
+        }
+
+      bool isNicNameNecessary = false;
+#if defined(__linux__)
+      // on Linux, the interface name is needed if there is more than one MulticastUdpFace
+      isNicNameNecessary = ipv4MulticastInterfaces.size() > 1;
+#endif
+
+      for (const auto& nic : ipv4MulticastInterfaces)
+        {
+          shared_ptr<MulticastUdpFace> newFace =
+            factory->createMulticastFace(nic.ipv4Addresses[0].to_string(),
+                                         mcastGroup, mcastPort,
+                                         isNicNameNecessary ? nic.name : "");
+          // a face that already exists is returned again on reload
+          if (newFace->getId() == INVALID_FACEID)
+            addCreatedFaceToForwarder(newFace);
+          multicastFacesToRemove.remove(newFace);
+        }
+    }
+
+  for (const auto& face : multicastFacesToRemove)
+    face->close();
 }
 
 void
@@ -66,7 +66,7 @@ FibEnumerationPublisher::generate(ndn::EncodingBuffer& outBuffer)
         {
           const fib::NextHop& next = *j;
           ndn::nfd::NextHopRecord nextHopRecord;
-          nextHopRecord.setFaceId(next.getFace()->getId());
+          nextHopRecord.setFaceId(next.getFace().getId());
           nextHopRecord.setCost(next.getCost());
 
           tlvEntry.addNextHopRecord(nextHopRecord);
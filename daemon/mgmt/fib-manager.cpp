@@ -203,7 +203,7 @@ FibManager::addNextHop(ControlParameters& parameters,
     {
       shared_ptr<fib::Entry> entry = m_managedFib.insert(prefix).first;
 
-      entry->addNextHop(nextHopFace, cost);
+      entry->addNextHop(*nextHopFace, cost);
 
       NFD_LOG_DEBUG("add-nexthop result: OK"
                     << " prefix:" << prefix
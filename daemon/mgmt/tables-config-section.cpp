@@ -24,6 +24,7 @@
  */
 
 #include "tables-config-section.hpp"
+#include "fw/forwarder.hpp"
 
 #include "common.hpp"
 #include "core/logger.hpp"
@@ -35,16 +36,14 @@ NFD_LOG_INIT("TablesConfigSection");
 
 const size_t TablesConfigSection::DEFAULT_CS_MAX_PACKETS = 65536;
 
-TablesConfigSection::TablesConfigSection(Cs& cs,
-                                         Pit& pit,
-                                         Fib& fib,
-                                         StrategyChoice& strategyChoice,
-                                         Measurements& measurements)
-  : m_cs(cs)
-  // , m_pit(pit)
-  // , m_fib(fib)
-  , m_strategyChoice(strategyChoice)
-  // , m_measurements(measurements)
+TablesConfigSection::TablesConfigSection(Forwarder& forwarder)
+  : m_cs(forwarder.getCs())
+  // , m_pit(forwarder.getPit())
+  // , m_fib(forwarder.getFib())
+  , m_strategyChoice(forwarder.getStrategyChoice())
+  // , m_measurements(forwarder.getMeasurements())
+  , m_deadNonceList(forwarder.getDeadNonceList())
+  , m_forwarder(forwarder)
   , m_areTablesConfigured(false)
 {
 
@@ -80,6 +79,8 @@ TablesConfigSection::onConfig(const ConfigSection& configSection,
   // tables
   // {
   //    cs_max_packets 65536
+  //    dnl_filter_capacity 0
+  //    straggler_duration 100
   //
   //    strategy_choice
   //    {
@@ -109,6 +110,45 @@ TablesConfigSection::onConfig(const ConfigSection& configSection,
       nCsMaxPackets = *valCsMaxPackets;
     }
 
+  size_t nDnlFilterCapacity = 0;
+
+  boost::optional<const ConfigSection&> dnlFilterCapacityNode =
+    configSection.get_child_optional("dnl_filter_capacity");
+
+  if (dnlFilterCapacityNode)
+    {
+      boost::optional<size_t> valDnlFilterCapacity =
+        configSection.get_optional<size_t>("dnl_filter_capacity");
+
+      if (!valDnlFilterCapacity)
+        {
+          BOOST_THROW_EXCEPTION(ConfigFile::Error("Invalid value for option \"dnl_filter_capacity\""
+                                                  " in \"tables\" section"));
+        }
+
+      nDnlFilterCapacity = *valDnlFilterCapacity;
+    }
+
+  time::milliseconds stragglerDuration =
+    time::duration_cast<time::milliseconds>(Forwarder::DEFAULT_STRAGGLER_DURATION);
+
+  boost::optional<const ConfigSection&> stragglerDurationNode =
+    configSection.get_child_optional("straggler_duration");
+
+  if (stragglerDurationNode)
+    {
+      boost::optional<size_t> valStragglerDuration =
+        configSection.get_optional<size_t>("straggler_duration");
+
+      if (!valStragglerDuration)
+        {
+          BOOST_THROW_EXCEPTION(ConfigFile::Error("Invalid value for option \"straggler_duration\""
+                                                  " in \"tables\" section"));
+        }
+
+      stragglerDuration = time::milliseconds(*valStragglerDuration);
+    }
+
   boost::optional<const ConfigSection&> strategyChoiceSection =
     configSection.get_child_optional("strategy_choice");
 
@@ -122,6 +162,13 @@ TablesConfigSection::onConfig(const ConfigSection& configSection,
       NFD_LOG_INFO("Setting CS max packets to " << nCsMaxPackets);
 
       m_cs.setLimit(nCsMaxPackets);
+
+      NFD_LOG_INFO("Setting Dead Nonce List filter capacity to " << nDnlFilterCapacity);
+      m_deadNonceList.setFilterCapacity(nDnlFilterCapacity);
+
+      NFD_LOG_INFO("Setting PIT straggler duration to " << stragglerDuration);
+      m_forwarder.setStragglerDuration(stragglerDuration);
+
       m_areTablesConfigured = true;
     }
 }
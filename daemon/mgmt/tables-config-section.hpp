@@ -31,19 +31,19 @@
 #include "table/cs.hpp"
 #include "table/measurements.hpp"
 #include "table/strategy-choice.hpp"
+#include "table/dead-nonce-list.hpp"
 
 #include "core/config-file.hpp"
 
 namespace nfd {
 
+class Forwarder;
+
 class TablesConfigSection
 {
 public:
-  TablesConfigSection(Cs& cs,
-                      Pit& pit,
-                      Fib& fib,
-                      StrategyChoice& strategyChoice,
-                      Measurements& measurements);
+  explicit
+  TablesConfigSection(Forwarder& forwarder);
 
   void
   setConfigFile(ConfigFile& configFile);
@@ -68,6 +68,8 @@ private:
   // Fib& m_fib;
   StrategyChoice& m_strategyChoice;
   // Measurements& m_measurements;
+  DeadNonceList& m_deadNonceList;
+  Forwarder& m_forwarder;
 
   bool m_areTablesConfigured;
 
@@ -143,11 +143,7 @@ Nfd::initializeManagement()
   ConfigFile config(&ignoreRibAndLogSections);
   general::setConfigFile(config);
 
-  TablesConfigSection tablesConfig(m_forwarder->getCs(),
-                                   m_forwarder->getPit(),
-                                   m_forwarder->getFib(),
-                                   m_forwarder->getStrategyChoice(),
-                                   m_forwarder->getMeasurements());
+  TablesConfigSection tablesConfig(*m_forwarder);
   tablesConfig.setConfigFile(config);
 
   m_internalFace->getValidator().setConfigFile(config);
@@ -170,7 +166,7 @@ Nfd::initializeManagement()
 
   // add FIB entry for NFD Management Protocol
   shared_ptr<fib::Entry> entry = m_forwarder->getFib().insert("/localhost/nfd").first;
-  entry->addNextHop(m_internalFace, 0);
+  entry->addNextHop(*m_internalFace, 0);
 }
 
 void
@@ -185,11 +181,7 @@ Nfd::reloadConfigFile()
 
   general::setConfigFile(config);
 
-  TablesConfigSection tablesConfig(m_forwarder->getCs(),
-                                   m_forwarder->getPit(),
-                                   m_forwarder->getFib(),
-                                   m_forwarder->getStrategyChoice(),
-                                   m_forwarder->getMeasurements());
+  TablesConfigSection tablesConfig(*m_forwarder);
 
   tablesConfig.setConfigFile(config);
 
@@ -0,0 +1,167 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dead-nonce-filter.hpp"
+
+#include <numeric>
+
+namespace nfd {
+
+const size_t DeadNonceFilter::BUCKET_SIZE = 4;
+const size_t DeadNonceFilter::MAX_KICKS = 128;
+const double DeadNonceFilter::MAX_LOAD = 0.9;
+
+DeadNonceFilter::DeadNonceFilter(size_t nPartitions, size_t partitionCapacity)
+  : m_nPartitions(nPartitions)
+  , m_nBuckets(1)
+  , m_sizes(nPartitions, 0)
+  , m_current(0)
+  , m_kickSlot(0)
+  , m_nOverflows(0)
+{
+  if (m_nPartitions < 2) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("DeadNonceFilter needs at least 2 partitions"));
+  }
+
+  size_t minBuckets = static_cast<size_t>(partitionCapacity / (BUCKET_SIZE * MAX_LOAD)) + 1;
+  while (m_nBuckets < minBuckets) {
+    m_nBuckets <<= 1;
+  }
+  m_bucketMask = m_nBuckets - 1;
+
+  m_slots.assign(m_nPartitions * m_nBuckets * BUCKET_SIZE, 0);
+}
+
+DeadNonceFilter::Fingerprint
+DeadNonceFilter::makeFingerprint(Entry entry)
+{
+  // use the high bits; low bits select the bucket
+  Fingerprint fp = static_cast<Fingerprint>(entry >> 48);
+  // zero marks an empty slot
+  return fp == 0 ? 1 : fp;
+}
+
+size_t
+DeadNonceFilter::getAltIndex(size_t index, Fingerprint fp) const
+{
+  // partial-key cuckoo hashing: getAltIndex(getAltIndex(i, fp), fp) == i
+  return (index ^ (static_cast<size_t>(fp) * 0x5bd1e995)) & m_bucketMask;
+}
+
+DeadNonceFilter::Fingerprint*
+DeadNonceFilter::getBucket(size_t partition, size_t index)
+{
+  return &m_slots[(partition * m_nBuckets + index) * BUCKET_SIZE];
+}
+
+const DeadNonceFilter::Fingerprint*
+DeadNonceFilter::getBucket(size_t partition, size_t index) const
+{
+  return &m_slots[(partition * m_nBuckets + index) * BUCKET_SIZE];
+}
+
+bool
+DeadNonceFilter::hasInBucket(size_t partition, size_t index, Fingerprint fp) const
+{
+  const Fingerprint* bucket = this->getBucket(partition, index);
+  return std::find(bucket, bucket + BUCKET_SIZE, fp) != bucket + BUCKET_SIZE;
+}
+
+bool
+DeadNonceFilter::insertToBucket(size_t partition, size_t index, Fingerprint fp)
+{
+  Fingerprint* bucket = this->getBucket(partition, index);
+  Fingerprint* slot = std::find(bucket, bucket + BUCKET_SIZE, 0);
+  if (slot == bucket + BUCKET_SIZE) {
+    return false;
+  }
+  *slot = fp;
+  return true;
+}
+
+bool
+DeadNonceFilter::has(Entry entry) const
+{
+  Fingerprint fp = makeFingerprint(entry);
+  size_t i1 = static_cast<size_t>(entry) & m_bucketMask;
+  size_t i2 = this->getAltIndex(i1, fp);
+
+  for (size_t partition = 0; partition < m_nPartitions; ++partition) {
+    if (m_sizes[partition] == 0) {
+      continue;
+    }
+    if (this->hasInBucket(partition, i1, fp) || this->hasInBucket(partition, i2, fp)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool
+DeadNonceFilter::add(Entry entry)
+{
+  Fingerprint fp = makeFingerprint(entry);
+  size_t i1 = static_cast<size_t>(entry) & m_bucketMask;
+  size_t i2 = this->getAltIndex(i1, fp);
+
+  if (this->insertToBucket(m_current, i1, fp) || this->insertToBucket(m_current, i2, fp)) {
+    ++m_sizes[m_current];
+    return true;
+  }
+
+  // both buckets are full: relocate existing fingerprints to their alternate buckets
+  size_t index = i2;
+  for (size_t nKicks = 0; nKicks < MAX_KICKS; ++nKicks) {
+    m_kickSlot = (m_kickSlot + 1) % BUCKET_SIZE;
+    std::swap(fp, this->getBucket(m_current, index)[m_kickSlot]);
+    index = this->getAltIndex(index, fp);
+    if (this->insertToBucket(m_current, index, fp)) {
+      ++m_sizes[m_current];
+      return true;
+    }
+  }
+
+  // partition is overflown, the last displaced fingerprint is dropped
+  ++m_nOverflows;
+  return false;
+}
+
+void
+DeadNonceFilter::rotate()
+{
+  m_current = (m_current + 1) % m_nPartitions;
+
+  Fingerprint* first = this->getBucket(m_current, 0);
+  std::fill(first, first + m_nBuckets * BUCKET_SIZE, 0);
+  m_sizes[m_current] = 0;
+}
+
+size_t
+DeadNonceFilter::size() const
+{
+  return std::accumulate(m_sizes.begin(), m_sizes.end(), static_cast<size_t>(0));
+}
+
+} // namespace nfd
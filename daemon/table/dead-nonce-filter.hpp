@@ -0,0 +1,148 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_DEAD_NONCE_FILTER_HPP
+#define NFD_DAEMON_TABLE_DEAD_NONCE_FILTER_HPP
+
+#include "common.hpp"
+
+namespace nfd {
+
+/** \brief a ring of cuckoo filters, used as an approximate Dead Nonce List engine
+ *
+ *  The ring is divided into a fixed number of partitions, each being a cuckoo filter that
+ *  stores 16-bit fingerprints in buckets of four slots.
+ *  New entries are inserted into the current partition.
+ *  rotate() clears the oldest partition and makes it current, so that an entry is kept for
+ *  (nPartitions - 1) to nPartitions rotation intervals.
+ *
+ *  All storage is allocated upon construction, so memory usage is fixed and insertions
+ *  never allocate. Lookups may yield false positives at a bounded rate;
+ *  they never yield false negatives unless a partition overflows.
+ */
+class DeadNonceFilter : noncopyable
+{
+public:
+  /** \brief 64-bit hash of Name+Nonce, same as DeadNonceList entry
+   */
+  typedef uint64_t Entry;
+
+  /** \param nPartitions number of partitions in the ring, must be at least 2
+   *  \param partitionCapacity number of entries each partition is sized for
+   */
+  DeadNonceFilter(size_t nPartitions, size_t partitionCapacity);
+
+  /** \brief determines whether entry may exist in any partition
+   */
+  bool
+  has(Entry entry) const;
+
+  /** \brief inserts entry into current partition
+   *  \return false if current partition overflows, in which case an older entry
+   *          in the partition has been dropped
+   */
+  bool
+  add(Entry entry);
+
+  /** \brief clears the oldest partition and makes it current
+   */
+  void
+  rotate();
+
+  /** \return number of entries in all partitions
+   */
+  size_t
+  size() const;
+
+  /** \return number of buckets in each partition
+   */
+  size_t
+  getNBuckets() const;
+
+  /** \return number of entries dropped due to partition overflow
+   */
+  uint64_t
+  getNOverflows() const;
+
+private:
+  typedef uint16_t Fingerprint;
+
+  static Fingerprint
+  makeFingerprint(Entry entry);
+
+  size_t
+  getAltIndex(size_t index, Fingerprint fp) const;
+
+  /** \return first slot of bucket \p index in \p partition
+   */
+  Fingerprint*
+  getBucket(size_t partition, size_t index);
+
+  const Fingerprint*
+  getBucket(size_t partition, size_t index) const;
+
+  bool
+  hasInBucket(size_t partition, size_t index, Fingerprint fp) const;
+
+  bool
+  insertToBucket(size_t partition, size_t index, Fingerprint fp);
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  static const size_t BUCKET_SIZE;
+
+  /** \brief maximum number of relocations before an insertion is considered overflown
+   */
+  static const size_t MAX_KICKS;
+
+  /** \brief target load factor when sizing partitions
+   */
+  static const double MAX_LOAD;
+
+private:
+  size_t m_nPartitions;
+  size_t m_nBuckets; ///< buckets per partition, power of 2
+  size_t m_bucketMask;
+  std::vector<Fingerprint> m_slots;
+  std::vector<size_t> m_sizes; ///< number of entries in each partition
+  size_t m_current; ///< index of current partition
+  size_t m_kickSlot;
+  uint64_t m_nOverflows;
+};
+
+inline size_t
+DeadNonceFilter::getNBuckets() const
+{
+  return m_nBuckets;
+}
+
+inline uint64_t
+DeadNonceFilter::getNOverflows() const
+{
+  return m_nOverflows;
+}
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_DEAD_NONCE_FILTER_HPP
@@ -46,6 +46,7 @@ DeadNonceList::DeadNonceList(const time::nanoseconds& lifetime)
   : m_lifetime(lifetime)
   , m_queue(m_index.get<0>())
   , m_ht(m_index.get<1>())
+  , m_filterCapacity(0)
   , m_capacity(INITIAL_CAPACITY)
   , m_markInterval(m_lifetime / EXPECTED_MARK_COUNT)
   , m_adjustCapacityInterval(m_lifetime)
@@ -83,6 +84,9 @@ DeadNonceList::~DeadNonceList()
 size_t
 DeadNonceList::size() const
 {
+  if (m_filter != nullptr) {
+    return m_filter->size();
+  }
   return m_queue.size() - this->countMarks();
 }
 
@@ -90,6 +94,9 @@ bool
 DeadNonceList::has(const Name& name, uint32_t nonce) const
 {
   Entry entry = DeadNonceList::makeEntry(name, nonce);
+  if (m_filter != nullptr) {
+    return m_filter->has(entry);
+  }
   return m_ht.find(entry) != m_ht.end();
 }
 
@@ -97,11 +104,49 @@ void
 DeadNonceList::add(const Name& name, uint32_t nonce)
 {
   Entry entry = DeadNonceList::makeEntry(name, nonce);
+  if (m_filter != nullptr) {
+    if (!m_filter->add(entry)) {
+      NFD_LOG_TRACE("add filter overflow nOverflows=" << m_filter->getNOverflows());
+    }
+    return;
+  }
+
   m_queue.push_back(entry);
 
   this->evictEntries();
 }
 
+void
+DeadNonceList::setFilterCapacity(size_t filterCapacity)
+{
+  if (filterCapacity == m_filterCapacity) {
+    return;
+  }
+  m_filterCapacity = filterCapacity;
+
+  if (m_filterCapacity == 0) {
+    m_filter.reset();
+    m_actualMarkCounts.clear();
+    NFD_LOG_TRACE("setFilterCapacity engine=index");
+    return;
+  }
+
+  // drop Nonces held by the exact index, but keep the MARKs
+  for (Queue::iterator it = m_queue.begin(); it != m_queue.end();) {
+    if (*it == MARK) {
+      ++it;
+    }
+    else {
+      it = m_queue.erase(it);
+    }
+  }
+
+  size_t partitionCapacity = (m_filterCapacity + EXPECTED_MARK_COUNT - 1) / EXPECTED_MARK_COUNT;
+  m_filter.reset(new DeadNonceFilter(EXPECTED_MARK_COUNT + 1, partitionCapacity));
+  NFD_LOG_TRACE("setFilterCapacity engine=filter capacity=" << m_filterCapacity <<
+                " nBuckets=" << m_filter->getNBuckets());
+}
+
 DeadNonceList::Entry
 DeadNonceList::makeEntry(const Name& name, uint32_t nonce)
 {
@@ -119,18 +164,31 @@ DeadNonceList::countMarks() const
 void
 DeadNonceList::mark()
 {
+  if (m_filter != nullptr) {
+    m_filter->rotate();
+    m_markEvent = scheduler::schedule(m_markInterval, bind(&DeadNonceList::mark, this));
+    return;
+  }
+
   m_queue.push_back(MARK);
   size_t nMarks = this->countMarks();
   m_actualMarkCounts.insert(nMarks);
 
   NFD_LOG_TRACE("mark nMarks=" << nMarks);
 
-  scheduler::schedule(m_markInterval, bind(&DeadNonceList::mark, this));
+  m_markEvent = scheduler::schedule(m_markInterval, bind(&DeadNonceList::mark, this));
 }
 
 void
 DeadNonceList::adjustCapacity()
 {
+  if (m_filter != nullptr) {
+    // filter has a fixed capacity; mark() does not collect counts
+    m_adjustCapacityEvent = scheduler::schedule(m_adjustCapacityInterval,
+                                                bind(&DeadNonceList::adjustCapacity, this));
+    return;
+  }
+
   std::pair<std::multiset<size_t>::iterator, std::multiset<size_t>::iterator> equalRange =
     m_actualMarkCounts.equal_range(EXPECTED_MARK_COUNT);
 
@@ -31,6 +31,7 @@
 #include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 #include "core/scheduler.hpp"
+#include "dead-nonce-filter.hpp"
 
 namespace nfd {
 
@@ -88,6 +89,22 @@ public:
   const time::nanoseconds&
   getLifetime() const;
 
+  /** \brief selects the storage engine
+   *  \param filterCapacity if zero, Nonces are stored in an exact index whose capacity
+   *         adapts to the insertion rate (default);
+   *         otherwise, Nonces are stored in a DeadNonceFilter sized for this many insertions
+   *         per lifetime, which has a fixed memory footprint and a bounded false positive rate
+   *
+   *  Nonces stored under the previous engine are discarded.
+   */
+  void
+  setFilterCapacity(size_t filterCapacity);
+
+  /** \return capacity of the filter engine, or zero if the exact index is in use
+   */
+  size_t
+  getFilterCapacity() const;
+
 private: // Entry and Index
   typedef uint64_t Entry;
 
@@ -144,6 +161,14 @@ private:
   Queue& m_queue;
   Hashtable& m_ht;
 
+  size_t m_filterCapacity;
+  /** \brief filter engine; if not null, it is used instead of m_index
+   *
+   *  The filter has EXPECTED_MARK_COUNT+1 partitions and is rotated upon each mark(),
+   *  so that each entry is kept for at least m_lifetime.
+   */
+  unique_ptr<DeadNonceFilter> m_filter;
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE: // actual lifetime estimation and capacity control
 
   // ---- current capacity and hard limits
@@ -217,6 +242,12 @@ DeadNonceList::getLifetime() const
   return m_lifetime;
 }
 
+inline size_t
+DeadNonceList::getFilterCapacity() const
+{
+  return m_filterCapacity;
+}
+
 } // namespace nfd
 
 #endif // NFD_DAEMON_TABLE_DEAD_NONCE_LIST_HPP
@@ -24,12 +24,16 @@
  */
 
 #include "fib-entry.hpp"
+#include "fib.hpp"
+
+#include <algorithm>
 
 namespace nfd {
 namespace fib {
 
 Entry::Entry(const Name& prefix)
   : m_prefix(prefix)
+  , m_fib(nullptr)
 {
 }
 
@@ -38,7 +42,7 @@ Entry::findNextHop(Face& face)
 {
   return std::find_if(m_nextHops.begin(), m_nextHops.end(),
                       [&face] (const NextHop& nexthop) {
-                        return nexthop.getFace().get() == &face;
+                        return &nexthop.getFace() == &face;
                       });
 }
 
@@ -49,19 +53,26 @@ Entry::hasNextHop(shared_ptr<Face> face) const
 }
 
 void
-Entry::addNextHop(shared_ptr<Face> face, uint64_t cost)
+Entry::addNextHop(Face& face, uint64_t cost)
 {
-  auto it = this->findNextHop(*face);
+  auto it = this->findNextHop(face);
   if (it == m_nextHops.end()) {
     m_nextHops.push_back(fib::NextHop(face));
     it = m_nextHops.end();
     --it;
+
+    if (m_fib != nullptr) {
+      m_fib->addToFaceIndex(face, *this);
+    }
+  }
+  else if (it->getCost() == cost) {
+    return;
   }
   // now it refers to the NextHop for face
 
   it->setCost(cost);
 
-  this->sortNextHops();
+  this->sortNextHop(it);
 }
 
 void
@@ -70,14 +81,27 @@ Entry::removeNextHop(shared_ptr<Face> face)
   auto it = this->findNextHop(*face);
   if (it != m_nextHops.end()) {
     m_nextHops.erase(it);
+
+    if (m_fib != nullptr) {
+      m_fib->removeFromFaceIndex(*face, *this);
+    }
   }
 }
 
 void
-Entry::sortNextHops()
+Entry::sortNextHop(NextHopList::iterator it)
 {
-  std::sort(m_nextHops.begin(), m_nextHops.end(),
-            [] (const NextHop& a, const NextHop& b) { return a.getCost() < b.getCost(); });
+  // all other nexthops are sorted; move *it to its place, keeping relative order of equal costs
+  auto compare = [] (const NextHop& a, const NextHop& b) { return a.getCost() < b.getCost(); };
+
+  auto before = std::upper_bound(m_nextHops.begin(), it, *it, compare);
+  if (before != it) {
+    std::rotate(before, it, it + 1);
+    return;
+  }
+
+  auto after = std::lower_bound(it + 1, m_nextHops.end(), *it, compare);
+  std::rotate(it, it + 1, after);
 }
 
 
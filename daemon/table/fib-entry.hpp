@@ -31,22 +31,13 @@
 namespace nfd {
 
 class NameTree;
+class Fib;
 namespace name_tree {
 class Entry;
 }
 
 namespace fib {
 
-/** \class NextHopList
- *  \brief represents a collection of nexthops
- *
- *  This type has these methods as public API:
- *    iterator<NextHop> begin()
- *    iterator<NextHop> end()
- *    size_t size()
- */
-typedef std::vector<fib::NextHop> NextHopList;
-
 /** \class Entry
  *  \brief represents a FIB entry
  */
@@ -77,14 +68,18 @@ public:
   /** \brief adds a NextHop record
    *
    *  If a NextHop record for face already exists, its cost is updated.
-   *  \note shared_ptr is passed by value because this function will take shared ownership
+   *  If this entry belongs to a Fib, the Fib's per-face index is updated.
+   *  \note The entry does not own the face. The NextHop record must be removed
+   *        before the face is destroyed; for an entry in a Fib, FaceTable does this
+   *        through Fib::removeNextHopFromAllEntries.
    */
   void
-  addNextHop(shared_ptr<Face> face, uint64_t cost);
+  addNextHop(Face& face, uint64_t cost);
 
   /** \brief removes a NextHop record
    *
    *  If no NextHop record for face exists, do nothing.
+   *  If this entry belongs to a Fib, the Fib's per-face index is updated.
    *
    *  \todo change parameter type to Face&
    */
@@ -97,9 +92,11 @@ private:
   NextHopList::iterator
   findNextHop(Face& face);
 
-  /// sorts the nexthop list
+  /** \brief moves one nexthop to keep the nexthop list sorted by cost
+   *  \pre all nexthops except \p it are sorted
+   */
   void
-  sortNextHops();
+  sortNextHop(NextHopList::iterator it);
 
 private:
   Name m_prefix;
@@ -108,6 +105,10 @@ private:
   shared_ptr<name_tree::Entry> m_nameTreeEntry;
   friend class nfd::NameTree;
   friend class nfd::name_tree::Entry;
+
+  /// the Fib this entry belongs to, or nullptr if this entry is not in a Fib
+  Fib* m_fib;
+  friend class nfd::Fib;
 };
 
 
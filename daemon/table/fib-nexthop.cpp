@@ -25,19 +25,22 @@
 
 #include "fib-nexthop.hpp"
 
+#include <algorithm>
+#include <memory>
+
 namespace nfd {
 namespace fib {
 
-NextHop::NextHop(shared_ptr<Face> face)
-  : m_face(face)
+NextHop::NextHop(Face& face)
+  : m_face(&face)
   , m_cost(0)
 {
 }
 
-const shared_ptr<Face>&
+Face&
 NextHop::getFace() const
 {
-  return m_face;
+  return *m_face;
 }
 
 void
@@ -52,5 +55,81 @@ NextHop::getCost() const
   return m_cost;
 }
 
+const size_t NextHopList::INLINE_CAPACITY;
+
+NextHopList::NextHopList()
+  : m_begin(reinterpret_cast<NextHop*>(m_inline))
+  , m_size(0)
+  , m_capacity(INLINE_CAPACITY)
+{
+}
+
+NextHopList::NextHopList(const NextHopList& other)
+  : NextHopList()
+{
+  *this = other;
+}
+
+NextHopList&
+NextHopList::operator=(const NextHopList& other)
+{
+  if (this != &other) {
+    m_size = 0;
+    if (other.m_size > m_capacity) {
+      this->grow(other.m_size);
+    }
+    std::uninitialized_copy(other.begin(), other.end(), m_begin);
+    m_size = other.m_size;
+  }
+  return *this;
+}
+
+NextHopList::~NextHopList()
+{
+  // NextHop is trivially destructible
+  if (!this->isInline()) {
+    ::operator delete(m_begin);
+  }
+}
+
+void
+NextHopList::push_back(const NextHop& nexthop)
+{
+  if (m_size == m_capacity) {
+    this->grow(m_capacity * 2);
+  }
+  new (m_begin + m_size) NextHop(nexthop);
+  ++m_size;
+}
+
+NextHopList::iterator
+NextHopList::erase(iterator it)
+{
+  BOOST_ASSERT(it >= this->begin() && it < this->end());
+  std::copy(it + 1, this->end(), it);
+  --m_size;
+  return it;
+}
+
+void
+NextHopList::clear()
+{
+  m_size = 0;
+}
+
+void
+NextHopList::grow(size_t minCapacity)
+{
+  size_t capacity = std::max<size_t>(minCapacity, m_capacity * 2);
+  NextHop* buffer = static_cast<NextHop*>(::operator new(capacity * sizeof(NextHop)));
+  std::uninitialized_copy(this->begin(), this->end(), buffer);
+
+  if (!this->isInline()) {
+    ::operator delete(m_begin);
+  }
+  m_begin = buffer;
+  m_capacity = static_cast<uint32_t>(capacity);
+}
+
 } // namespace fib
 } // namespace nfd
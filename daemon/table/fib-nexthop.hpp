@@ -29,19 +29,25 @@
 #include "common.hpp"
 #include "face/face.hpp"
 
+#include <type_traits>
+
 namespace nfd {
 namespace fib {
 
 /** \class NextHop
  *  \brief represents a nexthop record in FIB entry
+ *
+ *  The face is referenced by a plain pointer. This is safe because FaceTable removes
+ *  a face from all FIB entries before releasing it, and an entry erased from Fib
+ *  loses its nexthops.
  */
 class NextHop
 {
 public:
   explicit
-  NextHop(shared_ptr<Face> face);
+  NextHop(Face& face);
 
-  const shared_ptr<Face>&
+  Face&
   getFace() const;
 
   void
@@ -51,10 +57,133 @@ public:
   getCost() const;
 
 private:
-  shared_ptr<Face> m_face;
+  Face* m_face;
   uint64_t m_cost;
 };
 
+/** \class NextHopList
+ *  \brief represents a collection of nexthops
+ *
+ *  Up to INLINE_CAPACITY nexthops are stored inside the object, so that a typical
+ *  FIB entry does not need a separate allocation for its nexthops.
+ *  Iterators are pointers, and are invalidated by push_back and erase.
+ */
+class NextHopList
+{
+public:
+  typedef NextHop value_type;
+  typedef NextHop* iterator;
+  typedef const NextHop* const_iterator;
+
+  static const size_t INLINE_CAPACITY = 2;
+
+  NextHopList();
+
+  NextHopList(const NextHopList& other);
+
+  NextHopList&
+  operator=(const NextHopList& other);
+
+  ~NextHopList();
+
+  iterator
+  begin();
+
+  iterator
+  end();
+
+  const_iterator
+  begin() const;
+
+  const_iterator
+  end() const;
+
+  size_t
+  size() const;
+
+  bool
+  empty() const;
+
+  const NextHop&
+  operator[](size_t i) const;
+
+  void
+  push_back(const NextHop& nexthop);
+
+  /** \brief erases one nexthop, keeping the order of other nexthops
+   *  \return iterator following the erased nexthop
+   */
+  iterator
+  erase(iterator it);
+
+  void
+  clear();
+
+private:
+  bool
+  isInline() const;
+
+  /** \brief moves nexthops to a heap buffer of at least minCapacity
+   */
+  void
+  grow(size_t minCapacity);
+
+private:
+  NextHop* m_begin;
+  uint32_t m_size;
+  uint32_t m_capacity;
+  std::aligned_storage<sizeof(NextHop), alignof(NextHop)>::type m_inline[INLINE_CAPACITY];
+};
+
+inline NextHopList::iterator
+NextHopList::begin()
+{
+  return m_begin;
+}
+
+inline NextHopList::iterator
+NextHopList::end()
+{
+  return m_begin + m_size;
+}
+
+inline NextHopList::const_iterator
+NextHopList::begin() const
+{
+  return m_begin;
+}
+
+inline NextHopList::const_iterator
+NextHopList::end() const
+{
+  return m_begin + m_size;
+}
+
+inline size_t
+NextHopList::size() const
+{
+  return m_size;
+}
+
+inline bool
+NextHopList::empty() const
+{
+  return m_size == 0;
+}
+
+inline const NextHop&
+NextHopList::operator[](size_t i) const
+{
+  BOOST_ASSERT(i < m_size);
+  return m_begin[i];
+}
+
+inline bool
+NextHopList::isInline() const
+{
+  return m_begin == reinterpret_cast<const NextHop*>(m_inline);
+}
+
 } // namespace fib
 } // namespace nfd
 
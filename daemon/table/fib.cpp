@@ -46,6 +46,12 @@ static_assert(std::is_default_constructible<Fib::const_iterator>::value,
 BOOST_CONCEPT_ASSERT((boost::DefaultConstructible<Fib::const_iterator>));
 #endif // HAVE_IS_DEFAULT_CONSTRUCTIBLE
 
+static inline bool
+predicate_NameTreeEntry_hasFibEntry(const name_tree::Entry& entry)
+{
+  return static_cast<bool>(entry.getFibEntry());
+}
+
 Fib::Fib(NameTree& nameTree)
   : m_nameTree(nameTree)
   , m_nItems(0)
@@ -54,12 +60,11 @@ Fib::Fib(NameTree& nameTree)
 
 Fib::~Fib()
 {
-}
-
-static inline bool
-predicate_NameTreeEntry_hasFibEntry(const name_tree::Entry& entry)
-{
-  return static_cast<bool>(entry.getFibEntry());
+  // detach entries that may outlive this Fib
+  auto&& enumerable = m_nameTree.fullEnumerate(&predicate_NameTreeEntry_hasFibEntry);
+  for (const name_tree::Entry& nte : enumerable) {
+    nte.getFibEntry()->m_fib = nullptr;
+  }
 }
 
 shared_ptr<fib::Entry>
@@ -124,6 +129,7 @@ Fib::insert(const Name& prefix)
   if (static_cast<bool>(entry))
     return std::make_pair(entry, false);
   entry = make_shared<fib::Entry>(prefix);
+  entry->m_fib = this;
   nameTreeEntry->setFibEntry(entry);
   ++m_nItems;
   return std::make_pair(entry, true);
@@ -132,6 +138,14 @@ Fib::insert(const Name& prefix)
 void
 Fib::erase(shared_ptr<name_tree::Entry> nameTreeEntry)
 {
+  shared_ptr<fib::Entry> entry = nameTreeEntry->getFibEntry();
+  for (const fib::NextHop& nexthop : entry->getNextHops()) {
+    this->removeFromFaceIndex(nexthop.getFace(), *entry);
+  }
+  // nexthops must not outlive their faces, see fib::NextHop
+  entry->m_nextHops.clear();
+  entry->m_fib = nullptr;
+
   nameTreeEntry->setFibEntry(shared_ptr<fib::Entry>());
   m_nameTree.eraseEntryIfEmpty(nameTreeEntry);
   --m_nItems;
@@ -158,21 +172,66 @@ Fib::erase(const fib::Entry& entry)
 void
 Fib::removeNextHopFromAllEntries(shared_ptr<Face> face)
 {
-  std::list<fib::Entry*> toErase;
+  FaceIndex::iterator it = m_faceIndex.find(face.get());
+  if (it == m_faceIndex.end()) {
+    return;
+  }
 
-  auto&& enumerable = m_nameTree.fullEnumerate(&predicate_NameTreeEntry_hasFibEntry);
-  for (const name_tree::Entry& nte : enumerable) {
-    shared_ptr<fib::Entry> entry = nte.getFibEntry();
+  // take the entries out of the index first,
+  // so that removeNextHop and erase do not modify the set being iterated
+  std::unordered_set<fib::Entry*> entries;
+  entries.swap(it->second);
+  m_faceIndex.erase(it);
+
+  for (fib::Entry* entry : entries) {
     entry->removeNextHop(face);
     if (!entry->hasNextHops()) {
-      toErase.push_back(entry.get());
-      // entry needs to be erased, but we must wait until the enumeration ends,
-      // because otherwise NameTree iterator would be invalidated
+      this->erase(*entry);
     }
   }
+}
+
+std::vector<shared_ptr<fib::Entry>>
+Fib::findEntriesByNextHop(const Face& face) const
+{
+  std::vector<shared_ptr<fib::Entry>> entries;
+
+  FaceIndex::const_iterator it = m_faceIndex.find(&face);
+  if (it == m_faceIndex.end()) {
+    return entries;
+  }
+
+  entries.reserve(it->second.size());
+  for (fib::Entry* entry : it->second) {
+    entries.push_back(m_nameTree.get(*entry)->getFibEntry());
+  }
+  return entries;
+}
+
+size_t
+Fib::countEntriesByNextHop(const Face& face) const
+{
+  FaceIndex::const_iterator it = m_faceIndex.find(&face);
+  return it == m_faceIndex.end() ? 0 : it->second.size();
+}
+
+void
+Fib::addToFaceIndex(const Face& face, fib::Entry& entry)
+{
+  m_faceIndex[&face].insert(&entry);
+}
+
+void
+Fib::removeFromFaceIndex(const Face& face, fib::Entry& entry)
+{
+  FaceIndex::iterator it = m_faceIndex.find(&face);
+  if (it == m_faceIndex.end()) {
+    return;
+  }
 
-  for (fib::Entry* entry : toErase) {
-    this->erase(*entry);
+  it->second.erase(&entry);
+  if (it->second.empty()) {
+    m_faceIndex.erase(it);
   }
 }
 
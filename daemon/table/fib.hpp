@@ -86,12 +86,25 @@ public: // mutation
    *
    *  This is usually invoked when face goes away.
    *  Removing the last NextHop in a FIB entry will erase the FIB entry.
+   *  Only entries with a NextHop record for face are visited.
    *
    *  \todo change parameter type to Face&
    */
   void
   removeNextHopFromAllEntries(shared_ptr<Face> face);
 
+public: // per-face index
+  /** \return FIB entries that have a NextHop record for face
+   *  \note Order is undefined.
+   */
+  std::vector<shared_ptr<fib::Entry>>
+  findEntriesByNextHop(const Face& face) const;
+
+  /** \return number of FIB entries that have a NextHop record for face
+   */
+  size_t
+  countEntriesByNextHop(const Face& face) const;
+
 public: // enumeration
   class const_iterator;
 
@@ -149,10 +162,27 @@ private:
   void
   erase(shared_ptr<name_tree::Entry> nameTreeEntry);
 
+private: // per-face index, maintained by fib::Entry
+  void
+  addToFaceIndex(const Face& face, fib::Entry& entry);
+
+  void
+  removeFromFaceIndex(const Face& face, fib::Entry& entry);
+
+  friend class fib::Entry;
+
 private:
   NameTree& m_nameTree;
   size_t m_nItems;
 
+  /** \brief reverse index from nexthop face to FIB entries
+   *
+   *  Face is keyed by address rather than FaceId, because FaceTable resets FaceId
+   *  before invoking removeNextHopFromAllEntries.
+   */
+  typedef std::unordered_map<const Face*, std::unordered_set<fib::Entry*>> FaceIndex;
+  FaceIndex m_faceIndex;
+
   /** \brief The empty FIB entry.
    *
    *  This entry has no nexthops.
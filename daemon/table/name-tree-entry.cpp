@@ -47,6 +47,8 @@ Node::~Node()
 Entry::Entry(const Name& name)
   : m_hash(0)
   , m_prefix(name)
+  , m_effectiveStrategy(nullptr)
+  , m_effectiveStrategyVersion(0)
 {
 }
 
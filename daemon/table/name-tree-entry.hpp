@@ -35,6 +35,11 @@
 namespace nfd {
 
 class NameTree;
+class StrategyChoice;
+
+namespace fw {
+class Strategy;
+} // namespace fw
 
 namespace name_tree {
 
@@ -141,8 +146,15 @@ private:
   // get the Name Tree Node that is associated with this Name Tree Entry
   Node* m_node;
 
+  // Effective strategy of this prefix, cached by StrategyChoice.
+  // The cache is valid only if m_effectiveStrategyVersion equals StrategyChoice's version,
+  // which is bumped on every change to the Strategy Choice table.
+  fw::Strategy* m_effectiveStrategy;
+  uint64_t m_effectiveStrategyVersion;
+
   // Make private members accessible by Name Tree
   friend class nfd::NameTree;
+  friend class nfd::StrategyChoice;
 };
 
 inline const Name&
@@ -33,7 +33,9 @@ const Name Entry::LOCALHOST_NAME("ndn:/localhost");
 const Name Entry::LOCALHOP_NAME("ndn:/localhop");
 
 Entry::Entry(const Interest& interest)
-  : m_interest(interest.shared_from_this())
+  : m_stragglerSeq(0)
+  , m_interest(interest.shared_from_this())
+  , m_nonceBloom(0)
 {
 }
 
@@ -102,6 +104,11 @@ Entry::findNonce(uint32_t nonce, const Face& face) const
 
   int dnw = DUPLICATE_NONCE_NONE;
 
+  uint64_t bits = makeNonceBloomBits(nonce);
+  if ((m_nonceBloom & bits) != bits) {
+    return dnw;
+  }
+
   for (const InRecord& inRecord : m_inRecords) {
     if (inRecord.getLastNonce() == nonce) {
       if (inRecord.getFace().get() == &face) {
@@ -127,6 +134,26 @@ Entry::findNonce(uint32_t nonce, const Face& face) const
   return dnw;
 }
 
+uint64_t
+Entry::makeNonceBloomBits(uint32_t nonce)
+{
+  // Nonces are random, so two 6-bit slices serve as two independent hash functions
+  return (static_cast<uint64_t>(1) << (nonce & 0x3F)) |
+         (static_cast<uint64_t>(1) << ((nonce >> 6) & 0x3F));
+}
+
+void
+Entry::rebuildNonceBloom()
+{
+  m_nonceBloom = 0;
+  for (const InRecord& inRecord : m_inRecords) {
+    m_nonceBloom |= makeNonceBloomBits(inRecord.getLastNonce());
+  }
+  for (const OutRecord& outRecord : m_outRecords) {
+    m_nonceBloom |= makeNonceBloomBits(outRecord.getLastNonce());
+  }
+}
+
 InRecordCollection::iterator
 Entry::insertOrUpdateInRecord(shared_ptr<Face> face, const Interest& interest)
 {
@@ -138,6 +165,7 @@ Entry::insertOrUpdateInRecord(shared_ptr<Face> face, const Interest& interest)
   }
 
   it->update(interest);
+  m_nonceBloom |= makeNonceBloomBits(it->getLastNonce());
   return it;
 }
 
@@ -152,6 +180,7 @@ void
 Entry::deleteInRecords()
 {
   m_inRecords.clear();
+  this->rebuildNonceBloom();
 }
 
 OutRecordCollection::iterator
@@ -165,6 +194,7 @@ Entry::insertOrUpdateOutRecord(shared_ptr<Face> face, const Interest& interest)
   }
 
   it->update(interest);
+  m_nonceBloom |= makeNonceBloomBits(it->getLastNonce());
   return it;
 }
 
@@ -182,6 +212,7 @@ Entry::deleteOutRecord(const Face& face)
     [&face] (const OutRecord& outRecord) { return outRecord.getFace().get() == &face; });
   if (it != m_outRecords.end()) {
     m_outRecords.erase(it);
+    this->rebuildNonceBloom();
   }
 }
 
@@ -101,6 +101,9 @@ public:
 
   /** \brief finds where a duplicate Nonce appears
    *  \return OR'ed DuplicateNonceWhere
+   *
+   *  The records are scanned only if the Nonce may be present according to a Bloom filter
+   *  of all Nonces in InRecords and OutRecords.
    */
   int
   findNonce(uint32_t nonce, const Face& face) const;
@@ -165,13 +168,34 @@ public: // OutRecord
 
 public:
   scheduler::EventId m_unsatisfyTimer;
-  scheduler::EventId m_stragglerTimer;
+
+  /** \brief sequence number of this entry's record in the straggler queue of Forwarder,
+   *         or 0 if this entry is not waiting for straggler expiry
+   */
+  uint64_t m_stragglerSeq;
+
+private:
+  static uint64_t
+  makeNonceBloomBits(uint32_t nonce);
+
+  /** \brief recomputes m_nonceBloom from existing records
+   */
+  void
+  rebuildNonceBloom();
 
 private:
   shared_ptr<const Interest> m_interest;
   InRecordCollection m_inRecords;
   OutRecordCollection m_outRecords;
 
+  /** \brief Bloom filter of Nonces in InRecords and OutRecords
+   *
+   *  Bits are set when a record is inserted or updated, and recomputed when records are deleted.
+   *  A Nonce replaced by a record update leaves its bits set, which can only cause
+   *  a false positive that is resolved by scanning the records.
+   */
+  uint64_t m_nonceBloom;
+
   static const Name LOCALHOST_NAME;
   static const Name LOCALHOP_NAME;
 
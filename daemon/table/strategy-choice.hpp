@@ -158,13 +158,25 @@ private:
                  fw::Strategy& oldStrategy,
                  fw::Strategy& newStrategy);
 
+  /** \brief get effective strategy for a NameTree entry
+   *
+   *  The result is cached on the NameTree entry until the Strategy Choice table changes.
+   */
   fw::Strategy&
-  findEffectiveStrategy(shared_ptr<name_tree::Entry> nte) const;
+  findEffectiveStrategy(const shared_ptr<name_tree::Entry>& nte) const;
 
 private:
   NameTree& m_nameTree;
   size_t m_nItems;
 
+  /** \brief version of the Strategy Choice table
+   *
+   *  This is incremented whenever the effective strategy of any prefix may have changed,
+   *  invalidating effective strategies cached on NameTree entries.
+   *  It starts at 1 so that a new NameTree entry (version 0) has no valid cache.
+   */
+  uint64_t m_version;
+
   typedef std::map<Name, shared_ptr<fw::Strategy> > StrategyInstanceTable;
   StrategyInstanceTable m_strategyInstances;
 };
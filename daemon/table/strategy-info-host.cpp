@@ -25,12 +25,97 @@
 
 #include "strategy-info-host.hpp"
 
+#include <algorithm>
+
 namespace nfd {
 
+StrategyInfoHost::StrategyInfoHost()
+{
+}
+
+StrategyInfoHost::StrategyInfoHost(const StrategyInfoHost& other)
+{
+  *this = other;
+}
+
+StrategyInfoHost&
+StrategyInfoHost::operator=(const StrategyInfoHost& other)
+{
+  if (this == &other) {
+    return *this;
+  }
+
+  std::copy(other.m_inline, other.m_inline + INLINE_CAPACITY, m_inline);
+  if (other.m_overflow != nullptr) {
+    m_overflow.reset(new std::map<int, shared_ptr<fw::StrategyInfo>>(*other.m_overflow));
+  }
+  else {
+    m_overflow.reset();
+  }
+  return *this;
+}
+
 void
 StrategyInfoHost::clearStrategyInfo()
 {
-  m_items.clear();
+  for (InlineItem& slot : m_inline) {
+    slot.item.reset();
+  }
+  m_overflow.reset();
+}
+
+shared_ptr<fw::StrategyInfo>*
+StrategyInfoHost::findItem(int typeId) const
+{
+  for (const InlineItem& slot : m_inline) {
+    if (slot.item != nullptr && slot.typeId == typeId) {
+      return const_cast<shared_ptr<fw::StrategyInfo>*>(&slot.item);
+    }
+  }
+
+  if (m_overflow != nullptr) {
+    auto it = m_overflow->find(typeId);
+    if (it != m_overflow->end()) {
+      return &it->second;
+    }
+  }
+  return nullptr;
+}
+
+shared_ptr<fw::StrategyInfo>&
+StrategyInfoHost::insertItem(int typeId)
+{
+  shared_ptr<fw::StrategyInfo>* item = this->findItem(typeId);
+  if (item != nullptr) {
+    return *item;
+  }
+
+  for (InlineItem& slot : m_inline) {
+    if (slot.item == nullptr) {
+      slot.typeId = typeId;
+      return slot.item;
+    }
+  }
+
+  if (m_overflow == nullptr) {
+    m_overflow.reset(new std::map<int, shared_ptr<fw::StrategyInfo>>);
+  }
+  return (*m_overflow)[typeId];
+}
+
+void
+StrategyInfoHost::eraseItem(int typeId)
+{
+  for (InlineItem& slot : m_inline) {
+    if (slot.item != nullptr && slot.typeId == typeId) {
+      slot.item.reset();
+      return;
+    }
+  }
+
+  if (m_overflow != nullptr) {
+    m_overflow->erase(typeId);
+  }
 }
 
 } // namespace nfd
@@ -35,6 +35,13 @@ namespace nfd {
 class StrategyInfoHost
 {
 public:
+  StrategyInfoHost();
+
+  StrategyInfoHost(const StrategyInfoHost& other);
+
+  StrategyInfoHost&
+  operator=(const StrategyInfoHost& other);
+
   /** \brief get a StrategyInfo item
    *  \tparam T type of StrategyInfo, must be a subclass of from nfd::fw::StrategyInfo
    *  \retval nullptr if no StrategyInfo of type T is stored
@@ -66,7 +73,45 @@ public:
   clearStrategyInfo();
 
 private:
-  std::map<int, shared_ptr<fw::StrategyInfo>> m_items;
+  /** \return pointer to the stored item of type \p typeId,
+   *          or nullptr if no such item is stored
+   */
+  shared_ptr<fw::StrategyInfo>*
+  findItem(int typeId) const;
+
+  /** \return reference to the item of type \p typeId, which is null if newly inserted
+   */
+  shared_ptr<fw::StrategyInfo>&
+  insertItem(int typeId);
+
+  /** \brief removes the item of type \p typeId, if any
+   */
+  void
+  eraseItem(int typeId);
+
+private:
+  /** \brief number of StrategyInfo items stored inside the host
+   *
+   *  A host normally carries items from a single strategy, rarely more than two.
+   */
+  static const size_t INLINE_CAPACITY = 2;
+
+  struct InlineItem
+  {
+    InlineItem()
+      : typeId(0)
+    {
+    }
+
+    int typeId;
+    shared_ptr<fw::StrategyInfo> item; ///< null if the slot is free
+  };
+
+  InlineItem m_inline[INLINE_CAPACITY];
+
+  /** \brief items that do not fit in m_inline, allocated on first use
+   */
+  unique_ptr<std::map<int, shared_ptr<fw::StrategyInfo>>> m_overflow;
 };
 
 
@@ -77,11 +122,11 @@ StrategyInfoHost::getStrategyInfo() const
   static_assert(std::is_base_of<fw::StrategyInfo, T>::value,
                 "T must inherit from StrategyInfo");
 
-  auto it = m_items.find(T::getTypeId());
-  if (it == m_items.end()) {
+  shared_ptr<fw::StrategyInfo>* item = this->findItem(T::getTypeId());
+  if (item == nullptr) {
     return nullptr;
   }
-  return static_pointer_cast<T, fw::StrategyInfo>(it->second);
+  return static_pointer_cast<T, fw::StrategyInfo>(*item);
 }
 
 template<typename T>
@@ -92,10 +137,10 @@ StrategyInfoHost::setStrategyInfo(shared_ptr<T> item)
                 "T must inherit from StrategyInfo");
 
   if (item == nullptr) {
-    m_items.erase(T::getTypeId());
+    this->eraseItem(T::getTypeId());
   }
   else {
-    m_items[T::getTypeId()] = item;
+    this->insertItem(T::getTypeId()) = item;
   }
 }
 
@@ -106,12 +151,11 @@ StrategyInfoHost::getOrCreateStrategyInfo(A&&... args)
   static_assert(std::is_base_of<fw::StrategyInfo, T>::value,
                 "T must inherit from StrategyInfo");
 
-  shared_ptr<T> item = this->getStrategyInfo<T>();
-  if (!static_cast<bool>(item)) {
+  shared_ptr<fw::StrategyInfo>& item = this->insertItem(T::getTypeId());
+  if (item == nullptr) {
     item = make_shared<T>(std::forward<A>(args)...);
-    this->setStrategyInfo(item);
   }
-  return item;
+  return static_pointer_cast<T, fw::StrategyInfo>(item);
 }
 
 } // namespace nfd
@@ -0,0 +1,142 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core/mpsc-queue.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <boost/thread.hpp>
+
+namespace nfd {
+namespace tests {
+
+BOOST_FIXTURE_TEST_SUITE(TestMpscQueue, BaseFixture)
+
+BOOST_AUTO_TEST_CASE(Capacity)
+{
+  MpscQueue<int> queue(5);
+  BOOST_CHECK_EQUAL(queue.capacity(), 8);
+}
+
+BOOST_AUTO_TEST_CASE(Fifo)
+{
+  MpscQueue<int> queue(8);
+  for (int i = 0; i < 5; ++i)
+    BOOST_CHECK(queue.push(int(i)));
+
+  std::vector<int> items;
+  auto collect = [&items] (int&& item) { items.push_back(item); };
+
+  BOOST_CHECK_EQUAL(queue.popBatch(collect, 3), 3);
+  BOOST_CHECK_EQUAL(queue.popBatch(collect), 2);
+  BOOST_CHECK_EQUAL(queue.popBatch(collect), 0);
+
+  std::vector<int> expected{0, 1, 2, 3, 4};
+  BOOST_CHECK_EQUAL_COLLECTIONS(items.begin(), items.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(DropTail)
+{
+  MpscQueue<int> queue(4);
+  for (int i = 0; i < 4; ++i)
+    BOOST_CHECK(queue.push(int(i)));
+  BOOST_CHECK(!queue.push(4));
+  BOOST_CHECK(!queue.push(5));
+  BOOST_CHECK_EQUAL(queue.getNDropped(), 2);
+
+  std::vector<int> items;
+  queue.popBatch([&items] (int&& item) { items.push_back(item); }, 1);
+  BOOST_CHECK(queue.push(6));
+
+  queue.popBatch([&items] (int&& item) { items.push_back(item); });
+  std::vector<int> expected{0, 1, 2, 3, 6};
+  BOOST_CHECK_EQUAL_COLLECTIONS(items.begin(), items.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(Wakeup)
+{
+  int nWakeups = 0;
+  MpscQueue<int> queue(8, [&nWakeups] { ++nWakeups; });
+  auto ignore = [] (int&&) {};
+
+  // initially idle consumer is woken up once
+  queue.push(1);
+  queue.push(2);
+  BOOST_CHECK_EQUAL(nWakeups, 1);
+
+  // consumer has not drained the queue, no wakeup
+  queue.popBatch(ignore, 1);
+  queue.push(3);
+  BOOST_CHECK_EQUAL(nWakeups, 1);
+
+  // consumer drained the queue, next push wakes it up
+  queue.popBatch(ignore);
+  queue.push(4);
+  BOOST_CHECK_EQUAL(nWakeups, 2);
+}
+
+BOOST_AUTO_TEST_CASE(MultipleProducers)
+{
+  static const int N_PRODUCERS = 4;
+  static const int N_ITEMS = 2000;
+
+  MpscQueue<std::pair<int, int>> queue(256);
+
+  std::vector<unique_ptr<boost::thread>> producers;
+  for (int p = 0; p < N_PRODUCERS; ++p) {
+    producers.emplace_back(new boost::thread([&queue, p] {
+      for (int i = 0; i < N_ITEMS; ++i) {
+        while (!queue.push(std::make_pair(p, i)))
+          boost::this_thread::yield();
+      }
+    }));
+  }
+
+  std::vector<int> next(N_PRODUCERS, 0);
+  bool isOrdered = true;
+  int nReceived = 0;
+  while (nReceived < N_PRODUCERS * N_ITEMS) {
+    size_t nPopped = queue.popBatch([&] (std::pair<int, int>&& item) {
+      isOrdered = isOrdered && item.second == next[item.first];
+      ++next[item.first];
+    });
+    if (nPopped == 0)
+      boost::this_thread::yield();
+    nReceived += nPopped;
+  }
+
+  for (auto& producer : producers)
+    producer->join();
+
+  BOOST_CHECK(isOrdered);
+  BOOST_CHECK_EQUAL(queue.popBatch([] (std::pair<int, int>&&) {}), 0);
+  for (int p = 0; p < N_PRODUCERS; ++p)
+    BOOST_CHECK_EQUAL(next[p], N_ITEMS);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
@@ -28,6 +28,7 @@
 #include "tests/test-common.hpp"
 
 #include <boost/thread.hpp>
+#include <array>
 
 namespace nfd {
 
@@ -167,6 +168,135 @@ BOOST_FIXTURE_TEST_CASE(ScopedEventIdMove, UnitTestTimeFixture)
   BOOST_CHECK_EQUAL(hit, 1);
 }
 
+BOOST_AUTO_TEST_CASE(ExactExpiry)
+{
+  // timers parked in different wheel levels must not be rounded to the wheel resolution
+  std::vector<ns3::Time> fired;
+  auto record = [&] { fired.push_back(ns3::Simulator::Now()); };
+
+  scheduler::schedule(time::microseconds(250), record);
+  scheduler::schedule(time::microseconds(37500), record);
+  scheduler::schedule(time::microseconds(5004100), record);
+  scheduler::schedule(time::hours(6), record); // beyond the top level
+  EventId cancelled = scheduler::schedule(time::milliseconds(4000), record);
+  scheduler::schedule(time::milliseconds(10), [&] { scheduler::cancel(cancelled); });
+
+  ns3::Simulator::Run();
+  ns3::Simulator::Destroy();
+
+  BOOST_REQUIRE_EQUAL(fired.size(), 4);
+  BOOST_CHECK_EQUAL(fired[0], ns3::MicroSeconds(250));
+  BOOST_CHECK_EQUAL(fired[1], ns3::MicroSeconds(37500));
+  BOOST_CHECK_EQUAL(fired[2], ns3::MicroSeconds(5004100));
+  BOOST_CHECK_EQUAL(fired[3], ns3::Hours(6));
+}
+
+BOOST_AUTO_TEST_CASE(CancelPromoted)
+{
+  int hit = 0;
+  EventId i = scheduler::schedule(time::milliseconds(200), [&] { ++hit; });
+  // at 199.5ms the timer has left the wheel and sits in the simulator event queue
+  scheduler::schedule(time::microseconds(199500), [&] { scheduler::cancel(i); });
+
+  ns3::Simulator::Run();
+  ns3::Simulator::Destroy();
+  BOOST_CHECK_EQUAL(hit, 0);
+}
+
+BOOST_AUTO_TEST_CASE(StaleEventId)
+{
+  int hit1 = 0, hit2 = 0;
+  EventId i1 = scheduler::schedule(time::milliseconds(10), [&] { ++hit1; });
+  EventId i1copy = i1;
+  scheduler::cancel(i1);
+  BOOST_CHECK(!i1);
+
+  // the timer record of i1 is recycled for i2
+  EventId i2 = scheduler::schedule(time::milliseconds(10), [&] { ++hit2; });
+  BOOST_CHECK(i2 != i1copy);
+  scheduler::cancel(i1copy);
+
+  ns3::Simulator::Run();
+  ns3::Simulator::Destroy();
+  BOOST_CHECK_EQUAL(hit1, 0);
+  BOOST_CHECK_EQUAL(hit2, 1);
+}
+
+BOOST_AUTO_TEST_CASE(LargeCallback)
+{
+  // captures exceeding EventCallback::INLINE_SIZE are stored on the heap
+  std::array<int, 64> values;
+  values.fill(1);
+  int sum = 0;
+  scheduler::schedule(time::milliseconds(10), [values, &sum] {
+    for (int v : values) {
+      sum += v;
+    }
+  });
+
+  ns3::Simulator::Run();
+  ns3::Simulator::Destroy();
+  BOOST_CHECK_EQUAL(sum, 64);
+}
+
+/** \brief cancels an event when destroyed
+ */
+class CancelOnDestroy
+{
+public:
+  explicit
+  CancelOnDestroy(EventId& eventId)
+    : m_eventId(eventId)
+  {
+  }
+
+  ~CancelOnDestroy()
+  {
+    scheduler::cancel(m_eventId);
+  }
+
+private:
+  EventId& m_eventId;
+};
+
+BOOST_AUTO_TEST_CASE(CancelFromCallbackDestructor)
+{
+  int hit1 = 0, hit2 = 0;
+  EventId i1;
+  {
+    auto guard = make_shared<CancelOnDestroy>(i1);
+    i1 = scheduler::schedule(time::milliseconds(10), [guard, &hit1] { ++hit1; });
+  }
+  EventId i2 = scheduler::schedule(time::milliseconds(10), [&] { ++hit2; });
+
+  // destroying the callback of i1 re-enters cancel(i1)
+  EventId i1copy = i1;
+  scheduler::cancel(i1copy);
+
+  // a pending timer whose callback re-enters cancel when the simulator is destroyed
+  EventId i3;
+  {
+    auto guard = make_shared<CancelOnDestroy>(i3);
+    i3 = scheduler::schedule(time::seconds(60), [guard] {});
+  }
+
+  ns3::Simulator::Stop(ns3::Seconds(1));
+  ns3::Simulator::Run();
+  ns3::Simulator::Destroy();
+  BOOST_CHECK_EQUAL(hit1, 0);
+  BOOST_CHECK_EQUAL(hit2, 1);
+
+  // records must have been put on the free list once: two new timers get distinct records
+  int hit4 = 0, hit5 = 0;
+  EventId i4 = scheduler::schedule(time::milliseconds(10), [&] { ++hit4; });
+  EventId i5 = scheduler::schedule(time::milliseconds(10), [&] { ++hit5; });
+  BOOST_CHECK(i4 != i5);
+  ns3::Simulator::Run();
+  ns3::Simulator::Destroy();
+  BOOST_CHECK_EQUAL(hit4, 1);
+  BOOST_CHECK_EQUAL(hit5, 1);
+}
+
 BOOST_AUTO_TEST_CASE(ThreadLocalScheduler)
 {
   scheduler::Scheduler* s1 = &scheduler::getGlobalScheduler();
@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face/datagram-batch.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+using boost::asio::ip::udp;
+
+BOOST_FIXTURE_TEST_SUITE(FaceDatagramBatch, BaseFixture)
+
+static Block
+makeDatagram(size_t size)
+{
+  return ndn::makeBinaryBlock(tlv::Content, std::vector<uint8_t>(size, 0xBB).data(), size);
+}
+
+BOOST_AUTO_TEST_CASE(SendReceive)
+{
+  udp::socket receiver(g_io, udp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+  udp::socket sender(g_io, udp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+  udp::endpoint receiverEndpoint = receiver.local_endpoint();
+
+  std::deque<Block> datagrams;
+  for (size_t i = 1; i <= DatagramBatch::MAX_BATCH_SIZE + 8; ++i)
+    datagrams.push_back(makeDatagram(i * 10));
+  size_t nDatagrams = datagrams.size();
+
+  size_t nSent = 0;
+  while (!datagrams.empty()) {
+    boost::system::error_code error;
+    size_t n = DatagramBatch::send(sender.native_handle(), datagrams,
+                                   receiverEndpoint.data(), receiverEndpoint.size(), error);
+    BOOST_REQUIRE_MESSAGE(!error, error.message());
+    BOOST_REQUIRE_LE(n, DatagramBatch::MAX_BATCH_SIZE);
+    BOOST_REQUIRE_GT(n, 0);
+    datagrams.erase(datagrams.begin(), datagrams.begin() + n);
+    nSent += n;
+  }
+  BOOST_CHECK_EQUAL(nSent, nDatagrams);
+
+  DatagramBatch batch;
+  size_t nReceived = 0;
+  while (nReceived < nDatagrams) {
+    boost::system::error_code error;
+    size_t n = batch.receive(receiver.native_handle(), error);
+    BOOST_REQUIRE_MESSAGE(!error, error.message());
+    BOOST_REQUIRE_GT(n, 0);
+    for (size_t i = 0; i < n; ++i) {
+      BOOST_CHECK_EQUAL(batch.getSource<udp::endpoint>(i), sender.local_endpoint());
+
+      Block expected = makeDatagram((nReceived + i + 1) * 10);
+      BOOST_CHECK_EQUAL_COLLECTIONS(batch.getDatagram(i),
+                                    batch.getDatagram(i) + batch.getDatagramSize(i),
+                                    expected.begin(), expected.end());
+    }
+    nReceived += n;
+  }
+
+  // nothing more is available
+  boost::system::error_code error;
+  BOOST_CHECK_EQUAL(batch.receive(receiver.native_handle(), error), 0);
+  BOOST_CHECK(!error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
@@ -0,0 +1,193 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face/ethernet-face.hpp"
+
+#ifdef HAVE_TPACKET_V3
+
+#include "face/ethernet-packet-ring.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <linux/if_packet.h>
+
+namespace nfd {
+namespace tests {
+
+BOOST_FIXTURE_TEST_SUITE(FaceEthernetPacketRing, BaseFixture)
+
+/** \brief builds a receive block in the TPACKET_V3 layout, as the kernel would
+ */
+class RxBlockBuilder
+{
+public:
+  RxBlockBuilder()
+    : m_storage(4096 / sizeof(uint64_t))
+    , m_offset(TPACKET_ALIGN(sizeof(tpacket_block_desc)))
+    , m_lastFrame(nullptr)
+  {
+    getDesc()->hdr.bh1.offset_to_first_pkt = m_offset;
+  }
+
+  /** \return pointer to the frame in the block
+   */
+  const uint8_t*
+  addFrame(const std::vector<uint8_t>& frame, uint8_t pktType)
+  {
+    uint8_t* pos = getBlock() + m_offset;
+    tpacket3_hdr* hdr = reinterpret_cast<tpacket3_hdr*>(pos);
+    sockaddr_ll* sll = reinterpret_cast<sockaddr_ll*>(pos + TPACKET_ALIGN(sizeof(tpacket3_hdr)));
+    size_t macOffset = TPACKET_ALIGN(TPACKET3_HDRLEN);
+    size_t frameSize = TPACKET_ALIGN(macOffset + frame.size());
+
+    hdr->tp_mac = macOffset;
+    hdr->tp_snaplen = frame.size();
+    hdr->tp_len = frame.size();
+    sll->sll_pkttype = pktType;
+    std::copy(frame.begin(), frame.end(), pos + macOffset);
+
+    if (m_lastFrame != nullptr) {
+      m_lastFrame->tp_next_offset = (pos - reinterpret_cast<uint8_t*>(m_lastFrame));
+    }
+    m_lastFrame = hdr;
+    m_offset += frameSize;
+    ++getDesc()->hdr.bh1.num_pkts;
+    return pos + macOffset;
+  }
+
+  void
+  setReady()
+  {
+    getDesc()->hdr.bh1.block_status = TP_STATUS_USER;
+  }
+
+  uint8_t*
+  getBlock()
+  {
+    return reinterpret_cast<uint8_t*>(m_storage.data());
+  }
+
+  tpacket_block_desc*
+  getDesc()
+  {
+    return reinterpret_cast<tpacket_block_desc*>(getBlock());
+  }
+
+private:
+  std::vector<uint64_t> m_storage;
+  size_t m_offset;
+  tpacket3_hdr* m_lastFrame;
+};
+
+BOOST_AUTO_TEST_CASE(ReceiveBlock)
+{
+  RxBlockBuilder builder;
+  std::vector<uint8_t> frame1(60, 0x11);
+  std::vector<uint8_t> frame2(1514, 0x22);
+  std::vector<uint8_t> frame3(75, 0x33);
+  const uint8_t* pos1 = builder.addFrame(frame1, PACKET_MULTICAST);
+  const uint8_t* pos2 = builder.addFrame(frame2, PACKET_OUTGOING);
+  const uint8_t* pos3 = builder.addFrame(frame3, PACKET_BROADCAST);
+
+  struct Received
+  {
+    const uint8_t* frame;
+    size_t length;
+    bool isOutgoing;
+  };
+  std::vector<Received> received;
+  auto f = [&received] (const uint8_t* frame, size_t length, bool isOutgoing) {
+    received.push_back({frame, length, isOutgoing});
+  };
+
+  // the kernel has not retired the block yet
+  BOOST_CHECK_EQUAL(EthernetPacketRing::receiveBlock(builder.getBlock(), f), -1);
+  BOOST_CHECK_EQUAL(received.size(), 0);
+
+  builder.setReady();
+  BOOST_CHECK_EQUAL(EthernetPacketRing::receiveBlock(builder.getBlock(), f), 3);
+  BOOST_REQUIRE_EQUAL(received.size(), 3);
+  BOOST_CHECK(received[0].frame == pos1);
+  BOOST_CHECK_EQUAL(received[0].length, frame1.size());
+  BOOST_CHECK_EQUAL(received[0].isOutgoing, false);
+  BOOST_CHECK(received[1].frame == pos2);
+  BOOST_CHECK_EQUAL(received[1].length, frame2.size());
+  BOOST_CHECK_EQUAL(received[1].isOutgoing, true);
+  BOOST_CHECK(received[2].frame == pos3);
+  BOOST_CHECK_EQUAL(received[2].length, frame3.size());
+  BOOST_CHECK_EQUAL(received[2].isOutgoing, false);
+  BOOST_CHECK_EQUAL_COLLECTIONS(pos2, pos2 + frame2.size(), frame2.begin(), frame2.end());
+
+  // the block is returned to the kernel
+  BOOST_CHECK_EQUAL(builder.getDesc()->hdr.bh1.block_status, TP_STATUS_KERNEL);
+  BOOST_CHECK_EQUAL(EthernetPacketRing::receiveBlock(builder.getBlock(), f), -1);
+  BOOST_CHECK_EQUAL(received.size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(RingFrameFilter)
+{
+  const ethernet::Address group = ethernet::getDefaultMulticastAddress();
+  const ethernet::Address local = ethernet::Address::fromString("02:00:00:00:00:01");
+  const ethernet::Address remote = ethernet::Address::fromString("02:00:00:00:00:02");
+
+  auto makeFrame = [] (const ethernet::Address& dst, const ethernet::Address& src,
+                       uint16_t etherType) {
+    std::vector<uint8_t> frame(ethernet::HDR_LEN + ethernet::MIN_DATA_LEN);
+    std::copy(dst.begin(), dst.end(), frame.begin());
+    std::copy(src.begin(), src.end(), frame.begin() + ethernet::ADDR_LEN);
+    frame[2 * ethernet::ADDR_LEN] = etherType >> 8;
+    frame[2 * ethernet::ADDR_LEN + 1] = etherType & 0xff;
+    return frame;
+  };
+
+  std::vector<uint8_t> frame = makeFrame(group, remote, ethernet::ETHERTYPE_NDN);
+  BOOST_CHECK_EQUAL(EthernetFace::isRingFrameWanted(frame.data(), frame.size(), false,
+                                                    group, local), true);
+  // sent by this host
+  BOOST_CHECK_EQUAL(EthernetFace::isRingFrameWanted(frame.data(), frame.size(), true,
+                                                    group, local), false);
+  // too short for an Ethernet header
+  BOOST_CHECK_EQUAL(EthernetFace::isRingFrameWanted(frame.data(), ethernet::HDR_LEN - 1, false,
+                                                    group, local), false);
+
+  frame = makeFrame(ethernet::getBroadcastAddress(), remote, ethernet::ETHERTYPE_NDN);
+  BOOST_CHECK_EQUAL(EthernetFace::isRingFrameWanted(frame.data(), frame.size(), false,
+                                                    group, local), false);
+
+  frame = makeFrame(group, local, ethernet::ETHERTYPE_NDN);
+  BOOST_CHECK_EQUAL(EthernetFace::isRingFrameWanted(frame.data(), frame.size(), false,
+                                                    group, local), false);
+
+  frame = makeFrame(group, remote, 0x0800);
+  BOOST_CHECK_EQUAL(EthernetFace::isRingFrameWanted(frame.data(), frame.size(), false,
+                                                    group, local), false);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
+
+#endif // HAVE_TPACKET_V3
@@ -71,6 +71,10 @@ BOOST_AUTO_TEST_CASE(Counters)
   BOOST_CHECK_EQUAL(counters.getNOutDatas()    , 0);
   BOOST_CHECK_EQUAL(counters.getNInBytes()     , 0);
   BOOST_CHECK_EQUAL(counters.getNOutBytes()    , 0);
+  BOOST_CHECK_EQUAL(counters.getNOutBytesCopied(), 0);
+  BOOST_CHECK_EQUAL(counters.getSendQueueLength(), 0);
+  BOOST_CHECK_EQUAL(counters.getSendQueueBytes(), 0);
+  BOOST_CHECK_EQUAL(counters.getNReassemblyDrops(), 0);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -96,6 +96,64 @@ BOOST_AUTO_TEST_CASE(FailTwice)
   BOOST_CHECK_EQUAL(face.failCount, 1);
 }
 
+class DecodeTestFace : public DummyFace
+{
+public:
+  using DummyFace::decodeAndDispatchInput;
+};
+
+BOOST_AUTO_TEST_CASE(DecodeLocalhostViolation)
+{
+  DecodeTestFace face;
+  BOOST_REQUIRE(!face.isLocal());
+
+  std::vector<Interest> receivedInterests;
+  std::vector<Data> receivedDatas;
+  face.onReceiveInterest.connect([&] (const Interest& interest) {
+    receivedInterests.push_back(interest);
+  });
+  face.onReceiveData.connect([&] (const Data& data) { receivedDatas.push_back(data); });
+
+  BOOST_CHECK(face.decodeAndDispatchInput(makeInterest("/localhost/A")->wireEncode()));
+  BOOST_CHECK(face.decodeAndDispatchInput(makeInterest("/localhostX/B")->wireEncode()));
+  BOOST_CHECK(face.decodeAndDispatchInput(makeData("/localhost/C")->wireEncode()));
+  BOOST_CHECK(face.decodeAndDispatchInput(makeData("/D/localhost")->wireEncode()));
+
+  BOOST_REQUIRE_EQUAL(receivedInterests.size(), 1);
+  BOOST_CHECK_EQUAL(receivedInterests[0].getName(), "/localhostX/B");
+  BOOST_REQUIRE_EQUAL(receivedDatas.size(), 1);
+  BOOST_CHECK_EQUAL(receivedDatas[0].getName(), "/D/localhost");
+
+  BOOST_CHECK_EQUAL(face.getCounters().getNInInterests(), 2);
+  BOOST_CHECK_EQUAL(face.getCounters().getNInDatas(), 2);
+}
+
+class LocalControlHeaderTestFace : public DummyLocalFace
+{
+public:
+  using DummyLocalFace::filterAndEncodeLocalControlHeader;
+  using DummyLocalFace::encodeLocalControlHeaderPrefix;
+};
+
+BOOST_AUTO_TEST_CASE(LocalControlHeaderPrefix)
+{
+  LocalControlHeaderTestFace face;
+  shared_ptr<Data> data = makeData("/A");
+  data->setIncomingFaceId(2581);
+
+  // feature disabled
+  BOOST_CHECK(!face.encodeLocalControlHeaderPrefix(*data).hasWire());
+
+  face.setLocalControlHeaderFeature(LOCAL_CONTROL_FEATURE_INCOMING_FACE_ID, true);
+  Block expected = face.filterAndEncodeLocalControlHeader(*data);
+  Block prefix = face.encodeLocalControlHeaderPrefix(*data);
+  BOOST_REQUIRE(prefix.hasWire());
+
+  std::vector<uint8_t> actual(prefix.begin(), prefix.end());
+  actual.insert(actual.end(), data->wireEncode().begin(), data->wireEncode().end());
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
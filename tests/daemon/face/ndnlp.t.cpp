@@ -154,6 +154,40 @@ BOOST_AUTO_TEST_CASE(Slice4)
   BOOST_CHECK_EQUAL(totalPayloadSize, block.size());
 }
 
+// slice a Block to four fragments without copying the payload
+BOOST_AUTO_TEST_CASE(SliceInPlace)
+{
+  uint8_t blockValue[5050];
+  memset(blockValue, 0xcc, sizeof(blockValue));
+  Block block = ndn::dataBlock(0x01, blockValue, sizeof(blockValue));
+
+  ndnlp::Slicer slicer(1500);
+  ndnlp::PacketArray pa = slicer.slice(block);
+  const ndnlp::FragmentArray& fragments = slicer.sliceInPlace(block);
+
+  BOOST_REQUIRE_EQUAL(fragments.size(), 4);
+
+  const uint8_t* expectedPayload = block.wire();
+  for (size_t i = 0; i < 4; ++i) {
+    const ndnlp::Fragment& fragment = fragments[i];
+    BOOST_CHECK(fragment.payload == expectedPayload);
+    expectedPayload += fragment.payloadSize;
+    BOOST_CHECK_LE(fragment.size(), 1500);
+
+    ndn::Buffer wire(fragment.header, fragment.headerSize);
+    wire.insert(wire.end(), fragment.payload, fragment.payload + fragment.payloadSize);
+
+    // same encoding as slice, except the sequence number
+    const Block& expected = pa->at(i);
+    BOOST_REQUIRE_EQUAL(wire.size(), expected.size());
+    BOOST_CHECK_EQUAL_COLLECTIONS(wire.begin(), wire.begin() + 6,
+                                  expected.begin(), expected.begin() + 6);
+    BOOST_CHECK_EQUAL_COLLECTIONS(wire.begin() + 14, wire.end(),
+                                  expected.begin() + 14, expected.end());
+  }
+  BOOST_CHECK(expectedPayload == block.wire() + block.size());
+}
+
 class ReassembleFixture : protected UnitTestTimeFixture
 {
 protected:
@@ -299,6 +333,116 @@ BOOST_FIXTURE_TEST_CASE(ReassembleTimeout, ReassembleFixture)
                                 block.begin(),          block.end());
 }
 
+// drop least recently active partial messages when over the memory limit
+BOOST_FIXTURE_TEST_CASE(ReassembleMemoryLimit, ReassembleFixture)
+{
+  Block block = makeBlock(2000);
+  ndnlp::PacketArray pa = slicer.slice(block);
+  BOOST_REQUIRE_EQUAL(pa->size(), 2);
+
+  Block block2 = makeBlock(2000);
+  ndnlp::PacketArray pa2 = slicer.slice(block2);
+  BOOST_REQUIRE_EQUAL(pa2->size(), 2);
+
+  auto sharedMemory = make_shared<ndnlp::ReassemblyMemory>(4000);
+  ndnlp::PartialMessageStore pms1(time::milliseconds(100), 4000, sharedMemory);
+  ndnlp::PartialMessageStore pms2(time::milliseconds(100), 4000, sharedMemory);
+  std::vector<Block> received1;
+  size_t nDrops1 = 0, nDrops2 = 0;
+  pms1.onReceive.connect([&] (const Block& packet) { received1.push_back(packet); });
+  pms1.onDrop.connect([&] { ++nDrops1; });
+  pms2.onDrop.connect([&] { ++nDrops2; });
+
+  auto receive = [] (ndnlp::PartialMessageStore& pms, const Block& block) {
+    bool isOk = false;
+    ndnlp::NdnlpData pkt;
+    std::tie(isOk, pkt) = ndnlp::NdnlpData::fromBlock(block);
+    BOOST_REQUIRE(isOk);
+    pms.receive(pkt);
+  };
+
+  // one partial message fits in 4000 octets, two do not
+  receive(pms1, pa->at(0));
+  BOOST_CHECK_GT(pms1.getMemorySize(), 2000);
+  receive(pms1, pa2->at(0));
+  BOOST_CHECK_EQUAL(nDrops1, 1);
+  BOOST_CHECK_EQUAL(sharedMemory->getUsed(), pms1.getMemorySize());
+
+  receive(pms1, pa2->at(1));
+  BOOST_REQUIRE_EQUAL(received1.size(), 1);
+  BOOST_CHECK_EQUAL_COLLECTIONS(received1.at(0).begin(), received1.at(0).end(),
+                                block2.begin(),          block2.end());
+  BOOST_CHECK_EQUAL(pms1.getMemorySize(), 0);
+  BOOST_CHECK_EQUAL(sharedMemory->getUsed(), 0);
+  BOOST_CHECK_EQUAL(nDrops1, 1);
+
+  // the shared limit is exceeded, so the least recently active message of any store is dropped
+  receive(pms1, pa->at(0));
+  this->advanceClocks(time::milliseconds(10));
+  receive(pms2, pa2->at(0));
+  BOOST_CHECK_EQUAL(nDrops1, 2);
+  BOOST_CHECK_EQUAL(nDrops2, 0);
+  BOOST_CHECK_EQUAL(pms1.getMemorySize(), 0);
+  BOOST_CHECK_EQUAL(sharedMemory->getUsed(), pms2.getMemorySize());
+}
+
+// a sender flooding its own store does not starve other stores sharing the memory limit
+BOOST_FIXTURE_TEST_CASE(ReassembleMemoryFlood, ReassembleFixture)
+{
+  // each partial message holds 2000 to 4000 octets, so at least three fit in the shared limit
+  auto sharedMemory = make_shared<ndnlp::ReassemblyMemory>(12000);
+  ndnlp::PartialMessageStore attackerPms(time::milliseconds(100),
+                                         ndnlp::PartialMessageStore::DEFAULT_MAX_BYTES,
+                                         sharedMemory);
+  ndnlp::PartialMessageStore victimPms(time::milliseconds(100),
+                                       ndnlp::PartialMessageStore::DEFAULT_MAX_BYTES,
+                                       sharedMemory);
+  std::vector<Block> victimReceived;
+  size_t nAttackerDrops = 0, nVictimDrops = 0;
+  victimPms.onReceive.connect([&] (const Block& packet) { victimReceived.push_back(packet); });
+  attackerPms.onDrop.connect([&] { ++nAttackerDrops; });
+  victimPms.onDrop.connect([&] { ++nVictimDrops; });
+
+  auto receive = [] (ndnlp::PartialMessageStore& pms, const Block& block) {
+    bool isOk = false;
+    ndnlp::NdnlpData pkt;
+    std::tie(isOk, pkt) = ndnlp::NdnlpData::fromBlock(block);
+    BOOST_REQUIRE(isOk);
+    pms.receive(pkt);
+  };
+
+  // the attacker sends first fragments of messages that are never completed
+  auto flood = [&] (int nMessages) {
+    for (int i = 0; i < nMessages; ++i) {
+      ndnlp::PacketArray pa = slicer.slice(makeBlock(2000));
+      BOOST_REQUIRE_EQUAL(pa->size(), 2);
+      receive(attackerPms, pa->at(0));
+      this->advanceClocks(time::milliseconds(1));
+    }
+  };
+
+  flood(10);
+  BOOST_CHECK_LE(sharedMemory->getUsed(), 12000);
+  BOOST_CHECK_EQUAL(sharedMemory->getUsed(), attackerPms.getMemorySize());
+
+  Block block = makeBlock(2000);
+  ndnlp::PacketArray pa = slicer.slice(block);
+  BOOST_REQUIRE_EQUAL(pa->size(), 2);
+  receive(victimPms, pa->at(0));
+  BOOST_CHECK_GT(victimPms.getMemorySize(), 0);
+  BOOST_CHECK_LE(sharedMemory->getUsed(), 12000);
+
+  flood(2);
+  receive(victimPms, pa->at(1));
+
+  BOOST_REQUIRE_EQUAL(victimReceived.size(), 1);
+  BOOST_CHECK_EQUAL_COLLECTIONS(victimReceived.at(0).begin(), victimReceived.at(0).end(),
+                                block.begin(),                block.end());
+  BOOST_CHECK_EQUAL(nVictimDrops, 0);
+  BOOST_CHECK_GT(nAttackerDrops, 0);
+  BOOST_CHECK_EQUAL(sharedMemory->getUsed(), attackerPms.getMemorySize());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
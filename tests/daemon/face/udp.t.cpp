@@ -529,6 +529,108 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(MultipleAccepts, A, EndToEndAddresses)
   BOOST_CHECK_EQUAL(faces1.at(1)->getRemoteUri(), A::getFaceUri3());
 }
 
+// channel listening on several SO_REUSEPORT sockets
+BOOST_AUTO_TEST_CASE_TEMPLATE(MultipleListenSockets, A, EndToEndAddresses)
+{
+  LimitedIo limitedIo;
+  UdpFactory factory;
+
+  shared_ptr<UdpChannel> channel1 = factory.createChannel(A::getLocalIp(), A::getPort1(),
+                                                          time::seconds(600), 4);
+  std::vector<shared_ptr<Face>> faces1;
+  channel1->listen([&] (shared_ptr<Face> newFace) {
+                     faces1.push_back(newFace);
+                     limitedIo.afterOp();
+                   },
+                   [] (const std::string& reason) { BOOST_ERROR(reason); });
+  BOOST_CHECK(channel1->isListening());
+
+  udp::Endpoint endpoint1(boost::asio::ip::address::from_string(A::getLocalIp()),
+                          boost::lexical_cast<uint16_t>(A::getPort1()));
+
+  // face2 (on channel2) and face3 (on channel3) connect to channel1
+  shared_ptr<UdpChannel> channel2 = factory.createChannel(A::getLocalIp(), A::getPort2());
+  shared_ptr<Face> face2;
+  channel2->connect(endpoint1, ndn::nfd::FACE_PERSISTENCY_PERSISTENT,
+                    [&] (shared_ptr<Face> newFace) {
+                      face2 = newFace;
+                      limitedIo.afterOp();
+                    },
+                    [] (const std::string& reason) { BOOST_ERROR(reason); });
+
+  shared_ptr<UdpChannel> channel3 = factory.createChannel(A::getLocalIp(), A::getPort3());
+  shared_ptr<Face> face3;
+  channel3->connect(endpoint1, ndn::nfd::FACE_PERSISTENCY_PERSISTENT,
+                    [&] (shared_ptr<Face> newFace) {
+                      face3 = newFace;
+                      limitedIo.afterOp();
+                    },
+                    [] (const std::string& reason) { BOOST_ERROR(reason); });
+
+  limitedIo.run(2, time::seconds(1)); // 2 creates (on channel2 and channel3)
+  BOOST_REQUIRE(face2 != nullptr);
+  BOOST_REQUIRE(face3 != nullptr);
+
+  shared_ptr<Interest> interest2 = makeInterest("/I2");
+  face2->sendInterest(*interest2);
+  shared_ptr<Data> data3 = makeData("/D3");
+  face3->sendData(*data3);
+
+  limitedIo.run(2, time::milliseconds(100)); // 2 accepts (on channel1)
+  BOOST_CHECK_EQUAL(faces1.size(), 2);
+  BOOST_CHECK_EQUAL(channel1->size(), 2);
+}
+
+// small packets sent together in one datagram
+BOOST_AUTO_TEST_CASE_TEMPLATE(Aggregation, A, EndToEndAddresses)
+{
+  LimitedIo limitedIo;
+  UdpFactory factory;
+
+  shared_ptr<UdpChannel> channel1 = factory.createChannel(A::getLocalIp(), A::getPort1());
+  channel1->enableAggregation(1400, time::microseconds(500));
+  shared_ptr<Face> face1;
+  factory.createFace(A::getFaceUri2(),
+                     ndn::nfd::FACE_PERSISTENCY_PERSISTENT,
+                     [&] (shared_ptr<Face> newFace) {
+                       face1 = newFace;
+                       limitedIo.afterOp();
+                     },
+                     [] (const std::string& reason) { BOOST_ERROR(reason); });
+
+  limitedIo.run(1, time::seconds(1));
+  BOOST_REQUIRE(face1 != nullptr);
+
+  shared_ptr<UdpChannel> channel2 = factory.createChannel(A::getLocalIp(), A::getPort2());
+  shared_ptr<Face> face2;
+  unique_ptr<FaceHistory> history2;
+  channel2->listen([&] (shared_ptr<Face> newFace) {
+                     face2 = newFace;
+                     history2.reset(new FaceHistory(*face2, limitedIo));
+                     limitedIo.afterOp();
+                   },
+                   [] (const std::string& reason) { BOOST_ERROR(reason); });
+
+  shared_ptr<Interest> interest1 = makeInterest("/I1");
+  shared_ptr<Data> data1 = makeData("/D1");
+  face1->sendInterest(*interest1);
+  face1->sendInterest(*interest1);
+  face1->sendInterest(*interest1);
+  face1->sendData(*data1);
+  size_t nPacketBytes = 3 * interest1->wireEncode().size() + data1->wireEncode().size();
+
+  limitedIo.run(5, time::seconds(1)); // 1 accept, 4 receives
+
+  BOOST_REQUIRE(face2 != nullptr);
+  BOOST_CHECK_EQUAL(history2->receivedInterests.size(), 3);
+  BOOST_CHECK_EQUAL(history2->receivedData.size(), 1);
+
+  // one datagram carries all four packets, with a few octets of overhead
+  BOOST_CHECK_GT(face1->getCounters().getNOutBytes(), nPacketBytes);
+  BOOST_CHECK_LE(face1->getCounters().getNOutBytes(), nPacketBytes + 4);
+  BOOST_CHECK_EQUAL(face2->getCounters().getNInBytes(), face1->getCounters().getNOutBytes());
+}
+
 // manually close a face
 BOOST_AUTO_TEST_CASE_TEMPLATE(ManualClose, A, EndToEndAddresses)
 {
@@ -617,6 +719,76 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(IdleClose, A, EndToEndAddresses)
   BOOST_CHECK_EQUAL(history2->failures.size(), 0); // face2 is outgoing face and never closed
 }
 
+// on-demand faces send and receive through the listen socket of the channel
+BOOST_AUTO_TEST_CASE_TEMPLATE(SharedSocketFaces, A, EndToEndAddresses)
+{
+  LimitedIo limitedIo;
+  UdpFactory factory;
+
+  // channel1 is listening, and its on-demand faces share the listen socket
+  shared_ptr<UdpChannel> channel1 = factory.createChannel(A::getLocalIp(), A::getPort1());
+  channel1->enableSharedSocketFaces();
+  shared_ptr<Face> face1;
+  unique_ptr<FaceHistory> history1;
+  channel1->listen([&] (shared_ptr<Face> newFace) {
+                     face1 = newFace;
+                     history1.reset(new FaceHistory(*face1, limitedIo));
+                     limitedIo.afterOp();
+                   },
+                   [] (const std::string& reason) { BOOST_ERROR(reason); });
+
+  // face2 (on channel2) connects to channel1
+  shared_ptr<UdpChannel> channel2 = factory.createChannel(A::getLocalIp(), A::getPort2());
+  shared_ptr<Face> face2;
+  unique_ptr<FaceHistory> history2;
+  boost::asio::ip::address ipAddress = boost::asio::ip::address::from_string(A::getLocalIp());
+  udp::Endpoint endpoint(ipAddress, boost::lexical_cast<uint16_t>(A::getPort1()));
+  channel2->connect(endpoint,
+                    ndn::nfd::FACE_PERSISTENCY_PERSISTENT,
+                    [&] (shared_ptr<Face> newFace) {
+                      face2 = newFace;
+                      history2.reset(new FaceHistory(*face2, limitedIo));
+                      limitedIo.afterOp();
+                    },
+                    [] (const std::string& reason) { BOOST_ERROR(reason); });
+
+  limitedIo.run(1, time::milliseconds(100)); // 1 create (on channel2)
+  BOOST_REQUIRE(face2 != nullptr);
+
+  shared_ptr<Interest> interest2 = makeInterest("/I2");
+  face2->sendInterest(*interest2);
+  face2->sendInterest(*interest2);
+
+  limitedIo.run(3, time::seconds(1)); // 1 accept (on channel1), 2 receives (on face1)
+  BOOST_REQUIRE(face1 != nullptr);
+  BOOST_CHECK_EQUAL(face1->getPersistency(), ndn::nfd::FACE_PERSISTENCY_ON_DEMAND);
+  BOOST_CHECK_EQUAL(history1->receivedInterests.size(), 2);
+  BOOST_CHECK_EQUAL(channel1->size(), 1);
+
+  // face1 replies through the listen socket
+  shared_ptr<Data> data1 = makeData("/I2");
+  face1->sendData(*data1);
+
+  limitedIo.run(1, time::seconds(1)); // 1 receive (on face2)
+  BOOST_REQUIRE_EQUAL(history2->receivedData.size(), 1);
+  BOOST_CHECK_EQUAL(history2->receivedData.front().getName(), data1->getName());
+
+  // closing face1 leaves the listen socket open for other peers
+  face1->close();
+  getGlobalIoService().poll();
+  BOOST_CHECK_EQUAL(history1->failures.size(), 1);
+  BOOST_CHECK_EQUAL(channel1->size(), 0);
+  BOOST_CHECK(channel1->isListening());
+
+  history1.reset();
+  face1.reset();
+  face2->sendInterest(*interest2);
+  limitedIo.run(2, time::seconds(1)); // 1 accept (on channel1), 1 receive (on new face1)
+  BOOST_REQUIRE(face1 != nullptr);
+  BOOST_CHECK_EQUAL(history1->receivedInterests.size(), 1);
+  BOOST_CHECK_EQUAL(channel1->size(), 1);
+}
+
 class FakeNetworkInterfaceFixture : public BaseFixture
 {
 public:
@@ -272,6 +272,115 @@ BOOST_FIXTURE_TEST_CASE(EndToEnd, EndToEndFixture)
   BOOST_CHECK_EQUAL(counters2.getNOutDatas()    , 3);
 }
 
+BOOST_FIXTURE_TEST_CASE(ManyPacketsPerRead, EndToEndFixture)
+{
+  UnixStreamFactory factory;
+
+  shared_ptr<UnixStreamChannel> channel1 = factory.createChannel(CHANNEL_PATH1);
+  channel1->listen(bind(&EndToEndFixture::channel1_onFaceCreated,   this, _1),
+                   bind(&EndToEndFixture::channel1_onConnectFailed, this, _1));
+
+  UnixStreamFace::protocol::socket client(g_io);
+  client.async_connect(UnixStreamFace::protocol::endpoint(CHANNEL_PATH1),
+                       bind(&EndToEndFixture::client_onConnect, this, _1));
+
+  BOOST_CHECK_MESSAGE(limitedIo.run(2, time::seconds(1)) == LimitedIo::EXCEED_OPS, "Connect");
+  BOOST_REQUIRE(static_cast<bool>(face1));
+
+  // more than MAX_NDN_PACKET_SIZE bytes in a single write
+  static const uint8_t content[3000] = {};
+  std::vector<Block> payloads;
+  for (int i = 0; i < 8; ++i) {
+    shared_ptr<Data> data = makeData(Name("ndn:/ManyPacketsPerRead").appendNumber(i));
+    data->setContent(content, sizeof(content));
+    signData(data);
+    payloads.push_back(data->wireEncode());
+  }
+  std::vector<boost::asio::const_buffer> buffers(payloads.begin(), payloads.end());
+
+  // last packet is split across two writes
+  Block lastPayload = payloads.back();
+  buffers.back() = boost::asio::buffer(lastPayload.wire(), lastPayload.size() / 2);
+
+  boost::asio::async_write(client, buffers,
+                           [] (const boost::system::error_code& error, size_t nBytesSent) {
+                             BOOST_CHECK_MESSAGE(!error, error.message());
+                           });
+
+  BOOST_CHECK_MESSAGE(limitedIo.run(7, time::seconds(1)) == LimitedIo::EXCEED_OPS,
+                      "Receive complete packets");
+  BOOST_CHECK_EQUAL(face1_receivedDatas.size(), 7);
+
+  boost::asio::async_write(client,
+                           boost::asio::buffer(lastPayload.wire() + lastPayload.size() / 2,
+                                               lastPayload.size() - lastPayload.size() / 2),
+                           [] (const boost::system::error_code& error, size_t nBytesSent) {
+                             BOOST_CHECK_MESSAGE(!error, error.message());
+                           });
+
+  BOOST_CHECK_MESSAGE(limitedIo.run(1, time::seconds(1)) == LimitedIo::EXCEED_OPS,
+                      "Receive split packet");
+
+  BOOST_REQUIRE_EQUAL(face1_receivedDatas.size(), 8);
+  for (int i = 0; i < 8; ++i) {
+    BOOST_CHECK_EQUAL(face1_receivedDatas[i].getName().get(-1).toNumber(), i);
+    BOOST_CHECK_EQUAL(face1_receivedDatas[i].getContent().value_size(), sizeof(content));
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(ManyPacketsPerWrite, EndToEndFixture)
+{
+  UnixStreamFactory factory;
+
+  shared_ptr<UnixStreamChannel> channel1 = factory.createChannel(CHANNEL_PATH1);
+  channel1->listen(bind(&EndToEndFixture::channel1_onFaceCreated,   this, _1),
+                   bind(&EndToEndFixture::channel1_onConnectFailed, this, _1));
+
+  UnixStreamFace::protocol::socket client(g_io);
+  client.async_connect(UnixStreamFace::protocol::endpoint(CHANNEL_PATH1),
+                       bind(&EndToEndFixture::client_onConnect, this, _1));
+
+  BOOST_CHECK_MESSAGE(limitedIo.run(2, time::seconds(1)) == LimitedIo::EXCEED_OPS, "Connect");
+  BOOST_REQUIRE(static_cast<bool>(face1));
+
+  face2 = makeFace(std::move(client));
+  face2->onReceiveData.connect(bind(&EndToEndFixture::face2_onReceiveData, this, _1));
+
+  // all packets are queued before the first write completes,
+  // and together they exceed the size of a single gathered write
+  static const uint8_t content[3000] = {};
+  static const int N_PACKETS = 40;
+  size_t nBytesSent = 0;
+  for (int i = 0; i < N_PACKETS; ++i) {
+    shared_ptr<Data> data = makeData(Name("ndn:/ManyPacketsPerWrite").appendNumber(i));
+    data->setContent(content, sizeof(content));
+    signData(data);
+    face1->sendData(*data);
+    nBytesSent += data->wireEncode().size();
+  }
+
+  const FaceCounters& counters1 = face1->getCounters();
+  BOOST_CHECK_EQUAL(counters1.getSendQueueLength(), N_PACKETS);
+  BOOST_CHECK_EQUAL(counters1.getSendQueueBytes(), nBytesSent);
+
+  BOOST_CHECK_MESSAGE(limitedIo.run(N_PACKETS, time::seconds(1)) == LimitedIo::EXCEED_OPS,
+                      "Receive all packets");
+
+  BOOST_REQUIRE_EQUAL(face2_receivedDatas.size(), N_PACKETS);
+  for (int i = 0; i < N_PACKETS; ++i) {
+    BOOST_CHECK_EQUAL(face2_receivedDatas[i].getName().get(-1).toNumber(), i);
+    BOOST_CHECK_EQUAL(face2_receivedDatas[i].getContent().value_size(), sizeof(content));
+  }
+
+  // let the last write completion handler run
+  limitedIo.run(LimitedIo::UNLIMITED_OPS, time::milliseconds(100));
+
+  BOOST_CHECK_EQUAL(counters1.getSendQueueLength(), 0);
+  BOOST_CHECK_EQUAL(counters1.getSendQueueBytes(), 0);
+  BOOST_CHECK_EQUAL(counters1.getNOutDatas(), N_PACKETS);
+  BOOST_CHECK_EQUAL(counters1.getNOutBytes(), nBytesSent);
+}
+
 BOOST_FIXTURE_TEST_CASE(MultipleAccepts, EndToEndFixture)
 {
   UnixStreamFactory factory;
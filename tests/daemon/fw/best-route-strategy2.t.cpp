@@ -56,9 +56,9 @@ BOOST_AUTO_TEST_CASE(Forward)
 
   Fib& fib = forwarder.getFib();
   shared_ptr<fib::Entry> fibEntry = fib.insert(Name()).first;
-  fibEntry->addNextHop(face1, 10);
-  fibEntry->addNextHop(face2, 20);
-  fibEntry->addNextHop(face3, 30);
+  fibEntry->addNextHop(*face1, 10);
+  fibEntry->addNextHop(*face2, 20);
+  fibEntry->addNextHop(*face3, 30);
 
   shared_ptr<Interest> interest = makeInterest("ndn:/BzgFBchqA");
   Pit& pit = forwarder.getPit();
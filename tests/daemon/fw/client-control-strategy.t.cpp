@@ -55,7 +55,7 @@ BOOST_AUTO_TEST_CASE(Forward3)
 
   Fib& fib = forwarder.getFib();
   shared_ptr<fib::Entry> fibEntry = fib.insert(Name()).first;
-  fibEntry->addNextHop(face2, 0);
+  fibEntry->addNextHop(*face2, 0);
 
   Pit& pit = forwarder.getPit();
 
@@ -57,7 +57,7 @@ BOOST_AUTO_TEST_CASE(SimpleExchange)
 
   Fib& fib = forwarder.getFib();
   shared_ptr<fib::Entry> fibEntry = fib.insert(Name("ndn:/A")).first;
-  fibEntry->addNextHop(face2, 0);
+  fibEntry->addNextHop(*face2, 0);
 
   BOOST_CHECK_EQUAL(forwarder.getCounters().getNInInterests (), 0);
   BOOST_CHECK_EQUAL(forwarder.getCounters().getNOutInterests(), 0);
@@ -99,7 +99,7 @@ BOOST_AUTO_TEST_CASE(CsMatched)
 
   Fib& fib = forwarder.getFib();
   shared_ptr<fib::Entry> fibEntry = fib.insert(Name("ndn:/A")).first;
-  fibEntry->addNextHop(face2, 0);
+  fibEntry->addNextHop(*face2, 0);
 
   Pit& pit = forwarder.getPit();
   BOOST_CHECK_EQUAL(pit.size(), 0);
@@ -439,7 +439,7 @@ BOOST_FIXTURE_TEST_CASE(InterestLoopWithShortLifetime, UnitTestTimeFixture) // B
 
   Fib& fib = forwarder.getFib();
   shared_ptr<fib::Entry> fibEntry = fib.insert(Name("ndn:/A")).first;
-  fibEntry->addNextHop(face2, 0);
+  fibEntry->addNextHop(*face2, 0);
 
   // receive an Interest
   shared_ptr<Interest> interest = makeInterest("ndn:/A/1");
@@ -460,6 +460,150 @@ BOOST_FIXTURE_TEST_CASE(InterestLoopWithShortLifetime, UnitTestTimeFixture) // B
   // an Interest if its Name+Nonce has appeared any point in the past.
 }
 
+class StragglerTestForwarder : public Forwarder
+{
+public:
+  StragglerTestForwarder()
+    : nFinalized(0)
+  {
+  }
+
+  using Forwarder::setStragglerTimer;
+  using Forwarder::cancelUnsatisfyAndStragglerTimer;
+  using Forwarder::m_isStragglerQueueSorted;
+
+protected:
+  virtual void
+  insertDeadNonceList(pit::Entry& pitEntry, bool isSatisfied,
+                      const time::milliseconds& dataFreshnessPeriod, Face* upstream)
+  {
+    // called once for each PIT entry that is finalized
+    ++nFinalized;
+    Forwarder::insertDeadNonceList(pitEntry, isSatisfied, dataFreshnessPeriod, upstream);
+  }
+
+public:
+  int nFinalized;
+};
+
+BOOST_FIXTURE_TEST_CASE(StragglerExpiry, UnitTestTimeFixture)
+{
+  StragglerTestForwarder forwarder;
+  Pit& pit = forwarder.getPit();
+  BOOST_REQUIRE(forwarder.getStragglerDuration() == time::milliseconds(100));
+
+  shared_ptr<pit::Entry> pitEntry = pit.insert(*makeInterest("ndn:/A")).first;
+  forwarder.setStragglerTimer(pitEntry, false);
+
+  this->advanceClocks(time::milliseconds(10), 9);
+  BOOST_CHECK_EQUAL(pit.size(), 1);
+  BOOST_CHECK_EQUAL(forwarder.nFinalized, 0);
+
+  this->advanceClocks(time::milliseconds(10), 3);
+  BOOST_CHECK_EQUAL(pit.size(), 0);
+  BOOST_CHECK_EQUAL(forwarder.nFinalized, 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(StragglerCancelled, UnitTestTimeFixture)
+{
+  StragglerTestForwarder forwarder;
+  Pit& pit = forwarder.getPit();
+
+  shared_ptr<pit::Entry> pitEntry = pit.insert(*makeInterest("ndn:/A")).first;
+  forwarder.setStragglerTimer(pitEntry, false);
+  this->advanceClocks(time::milliseconds(10), 5);
+
+  // the queued record becomes stale, and is skipped when it expires
+  forwarder.cancelUnsatisfyAndStragglerTimer(pitEntry);
+  this->advanceClocks(time::milliseconds(10), 20);
+  BOOST_CHECK_EQUAL(pit.size(), 1);
+  BOOST_CHECK_EQUAL(forwarder.nFinalized, 0);
+
+  forwarder.setStragglerTimer(pitEntry, false);
+  this->advanceClocks(time::milliseconds(10), 12);
+  BOOST_CHECK_EQUAL(pit.size(), 0);
+  BOOST_CHECK_EQUAL(forwarder.nFinalized, 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(StragglerResatisfied, UnitTestTimeFixture)
+{
+  StragglerTestForwarder forwarder;
+  Pit& pit = forwarder.getPit();
+
+  shared_ptr<pit::Entry> pitEntry = pit.insert(*makeInterest("ndn:/A")).first;
+  forwarder.setStragglerTimer(pitEntry, true);
+  this->advanceClocks(time::milliseconds(10), 5);
+
+  // satisfied again, as by a ContentStore hit: the entry is finalized only once,
+  // a straggler duration after it's satisfied for the last time
+  forwarder.cancelUnsatisfyAndStragglerTimer(pitEntry);
+  forwarder.setStragglerTimer(pitEntry, true);
+
+  this->advanceClocks(time::milliseconds(10), 6);
+  BOOST_CHECK_EQUAL(pit.size(), 1);
+  BOOST_CHECK_EQUAL(forwarder.nFinalized, 0);
+
+  this->advanceClocks(time::milliseconds(10), 6);
+  BOOST_CHECK_EQUAL(pit.size(), 0);
+  BOOST_CHECK_EQUAL(forwarder.nFinalized, 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(StragglerDurationShortened, UnitTestTimeFixture)
+{
+  StragglerTestForwarder forwarder;
+  Pit& pit = forwarder.getPit();
+
+  shared_ptr<pit::Entry> pitEntryA = pit.insert(*makeInterest("ndn:/A")).first;
+  forwarder.setStragglerTimer(pitEntryA, false);
+  this->advanceClocks(time::milliseconds(10), 1);
+
+  // B expires before A, although it's queued after A
+  forwarder.setStragglerDuration(time::milliseconds(20));
+  shared_ptr<pit::Entry> pitEntryB = pit.insert(*makeInterest("ndn:/B")).first;
+  forwarder.setStragglerTimer(pitEntryB, false);
+
+  this->advanceClocks(time::milliseconds(10), 4);
+  BOOST_REQUIRE_EQUAL(pit.size(), 1);
+  BOOST_CHECK_EQUAL(pit.begin()->getName(), Name("ndn:/A"));
+  BOOST_CHECK_EQUAL(forwarder.nFinalized, 1);
+
+  this->advanceClocks(time::milliseconds(10), 7);
+  BOOST_CHECK_EQUAL(pit.size(), 0);
+  BOOST_CHECK_EQUAL(forwarder.nFinalized, 2);
+}
+
+BOOST_FIXTURE_TEST_CASE(StragglerQueueSortedUnderLoad, UnitTestTimeFixture)
+{
+  StragglerTestForwarder forwarder;
+  Pit& pit = forwarder.getPit();
+
+  shared_ptr<pit::Entry> pitEntryA = pit.insert(*makeInterest("ndn:/A")).first;
+  forwarder.setStragglerTimer(pitEntryA, false); // expires at 100ms
+  this->advanceClocks(time::milliseconds(10), 1);
+
+  forwarder.setStragglerDuration(time::milliseconds(20));
+  BOOST_CHECK_EQUAL(forwarder.m_isStragglerQueueSorted, false);
+
+  // the queue never becomes empty, but is sorted again after A expires
+  for (int i = 0; i < 20; ++i) {
+    shared_ptr<pit::Entry> pitEntry =
+      pit.insert(*makeInterest(Name("ndn:/B").appendNumber(i))).first;
+    forwarder.setStragglerTimer(pitEntry, false);
+    this->advanceClocks(time::milliseconds(10), 1);
+    if (i < 7) {
+      BOOST_CHECK_EQUAL(forwarder.m_isStragglerQueueSorted, false);
+    }
+    else if (i > 8) {
+      BOOST_CHECK_EQUAL(forwarder.m_isStragglerQueueSorted, true);
+    }
+  }
+  BOOST_CHECK(pit.size() > 0);
+
+  this->advanceClocks(time::milliseconds(10), 5);
+  BOOST_CHECK_EQUAL(pit.size(), 0);
+  BOOST_CHECK_EQUAL(forwarder.nFinalized, 21);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
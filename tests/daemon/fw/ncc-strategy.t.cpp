@@ -59,8 +59,8 @@ BOOST_AUTO_TEST_CASE(FavorRespondingUpstream)
 
   Fib& fib = forwarder.getFib();
   shared_ptr<fib::Entry> fibEntry = fib.insert(Name()).first;
-  fibEntry->addNextHop(face1, 10);
-  fibEntry->addNextHop(face2, 20);
+  fibEntry->addNextHop(*face1, 10);
+  fibEntry->addNextHop(*face2, 20);
 
   StrategyChoice& strategyChoice = forwarder.getStrategyChoice();
   strategyChoice.install(strategy);
@@ -123,7 +123,7 @@ BOOST_AUTO_TEST_CASE(Bug1853)
 
   Fib& fib = forwarder.getFib();
   shared_ptr<fib::Entry> fibEntry = fib.insert(Name()).first;
-  fibEntry->addNextHop(face1, 10);
+  fibEntry->addNextHop(*face1, 10);
 
   StrategyChoice& strategyChoice = forwarder.getStrategyChoice();
   strategyChoice.install(strategy);
@@ -158,7 +158,7 @@ BOOST_AUTO_TEST_CASE(Bug1853)
   strategy->afterReceiveInterest(*face3, *interest2, fibEntry, pitEntry2);
 
   // FIB entry is changed before doPropagate executes
-  fibEntry->addNextHop(face2, 20);
+  fibEntry->addNextHop(*face2, 20);
   this->advanceClocks(time::milliseconds(10), time::milliseconds(1000));// should not crash
 }
 
@@ -179,8 +179,8 @@ BOOST_AUTO_TEST_CASE(Bug1961)
 
   Fib& fib = forwarder.getFib();
   shared_ptr<fib::Entry> fibEntry = fib.insert(Name()).first;
-  fibEntry->addNextHop(face1, 10);
-  fibEntry->addNextHop(face2, 20);
+  fibEntry->addNextHop(*face1, 10);
+  fibEntry->addNextHop(*face2, 20);
 
   StrategyChoice& strategyChoice = forwarder.getStrategyChoice();
   strategyChoice.install(strategy);
@@ -239,7 +239,7 @@ BOOST_AUTO_TEST_CASE(Bug1971)
 
   Fib& fib = forwarder.getFib();
   shared_ptr<fib::Entry> fibEntry = fib.insert(Name()).first;
-  fibEntry->addNextHop(face2, 10);
+  fibEntry->addNextHop(*face2, 10);
 
   StrategyChoice& strategyChoice = forwarder.getStrategyChoice();
   strategyChoice.install(strategy);
@@ -289,8 +289,8 @@ BOOST_AUTO_TEST_CASE(Bug1998)
 
   Fib& fib = forwarder.getFib();
   shared_ptr<fib::Entry> fibEntry = fib.insert(Name()).first;
-  fibEntry->addNextHop(face1, 10); // face1 is top-ranked nexthop
-  fibEntry->addNextHop(face2, 20);
+  fibEntry->addNextHop(*face1, 10); // face1 is top-ranked nexthop
+  fibEntry->addNextHop(*face2, 20);
 
   StrategyChoice& strategyChoice = forwarder.getStrategyChoice();
   strategyChoice.install(strategy);
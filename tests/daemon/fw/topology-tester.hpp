@@ -325,7 +325,7 @@ public:
     Forwarder& forwarder = this->getForwarder(i);
     Fib& fib = forwarder.getFib();
     shared_ptr<fib::Entry> fibEntry = fib.insert(prefix).first;
-    fibEntry->addNextHop(face, cost);
+    fibEntry->addNextHop(*face, cost);
   }
 
   /** \brief creates a producer application that answers every Interest with Data of same Name
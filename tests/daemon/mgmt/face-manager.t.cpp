@@ -527,6 +527,123 @@ BOOST_AUTO_TEST_CASE(TestProcessSectionUdpBadIdleTimeout)
                              "Invalid value for option \"idle_timeout\" in \"udp\" section"));
 }
 
+BOOST_AUTO_TEST_CASE(TestProcessSectionUdpListenSockets)
+{
+  const std::string CONFIG =
+    "face_system\n"
+    "{\n"
+    "  udp\n"
+    "  {\n"
+    "    listen_sockets 4\n"
+    "  }\n"
+    "}\n";
+
+  BOOST_CHECK_NO_THROW(parseConfig(CONFIG, true));
+}
+
+BOOST_AUTO_TEST_CASE(TestProcessSectionUdpBadListenSockets)
+{
+  const std::string CONFIG_ZERO =
+    "face_system\n"
+    "{\n"
+    "  udp\n"
+    "  {\n"
+    "    listen_sockets 0\n"
+    "  }\n"
+    "}\n";
+
+  BOOST_CHECK_EXCEPTION(parseConfig(CONFIG_ZERO, true), ConfigFile::Error,
+                        bind(&isExpectedException, _1,
+                             "Invalid value for option \"listen_sockets\" in \"udp\" section"));
+
+  const std::string CONFIG_NAN =
+    "face_system\n"
+    "{\n"
+    "  udp\n"
+    "  {\n"
+    "    listen_sockets hello\n"
+    "  }\n"
+    "}\n";
+
+  BOOST_CHECK_EXCEPTION(parseConfig(CONFIG_NAN, true), ConfigFile::Error,
+                        bind(&isExpectedException, _1,
+                             "Invalid value for option \"listen_sockets\" in \"udp\" section"));
+}
+
+BOOST_AUTO_TEST_CASE(TestProcessSectionUdpAggregation)
+{
+  const std::string CONFIG =
+    "face_system\n"
+    "{\n"
+    "  udp\n"
+    "  {\n"
+    "    aggregate_size 1400\n"
+    "    aggregate_delay 200\n"
+    "  }\n"
+    "}\n";
+
+  BOOST_CHECK_NO_THROW(parseConfig(CONFIG, true));
+}
+
+BOOST_AUTO_TEST_CASE(TestProcessSectionUdpBadAggregation)
+{
+  const std::string CONFIG_TOO_LARGE =
+    "face_system\n"
+    "{\n"
+    "  udp\n"
+    "  {\n"
+    "    aggregate_size 100000\n"
+    "  }\n"
+    "}\n";
+
+  BOOST_CHECK_EXCEPTION(parseConfig(CONFIG_TOO_LARGE, true), ConfigFile::Error,
+                        bind(&isExpectedException, _1,
+                             "Invalid value for option \"aggregate_size\" in \"udp\" section"));
+
+  const std::string CONFIG_BAD_DELAY =
+    "face_system\n"
+    "{\n"
+    "  udp\n"
+    "  {\n"
+    "    aggregate_delay hello\n"
+    "  }\n"
+    "}\n";
+
+  BOOST_CHECK_EXCEPTION(parseConfig(CONFIG_BAD_DELAY, true), ConfigFile::Error,
+                        bind(&isExpectedException, _1,
+                             "Invalid value for option \"aggregate_delay\" in \"udp\" section"));
+}
+
+BOOST_AUTO_TEST_CASE(TestProcessSectionUdpSharedSocketFaces)
+{
+  const std::string CONFIG =
+    "face_system\n"
+    "{\n"
+    "  udp\n"
+    "  {\n"
+    "    shared_socket_faces yes\n"
+    "  }\n"
+    "}\n";
+
+  BOOST_CHECK_NO_THROW(parseConfig(CONFIG, true));
+}
+
+BOOST_AUTO_TEST_CASE(TestProcessSectionUdpBadSharedSocketFaces)
+{
+  const std::string CONFIG =
+    "face_system\n"
+    "{\n"
+    "  udp\n"
+    "  {\n"
+    "    shared_socket_faces hello\n"
+    "  }\n"
+    "}\n";
+
+  BOOST_CHECK_EXCEPTION(parseConfig(CONFIG, true), ConfigFile::Error,
+                        bind(&isExpectedException, _1,
+                             "Invalid value for option \"shared_socket_faces\" in \"udp\" section"));
+}
+
 BOOST_AUTO_TEST_CASE(TestProcessSectionUdpBadMcast)
 {
   const std::string CONFIG =
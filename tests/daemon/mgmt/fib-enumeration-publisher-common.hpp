@@ -97,7 +97,7 @@ public:
          i != nextHops.end();
          ++i)
       {
-        if (i->getFace()->getId() == faceId && i->getCost() == cost)
+        if (i->getFace().getId() == faceId && i->getCost() == cost)
           {
             return true;
           }
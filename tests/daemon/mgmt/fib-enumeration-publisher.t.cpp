@@ -42,6 +42,9 @@ BOOST_FIXTURE_TEST_SUITE(MgmtFibEnumerationPublisher, FibEnumerationPublisherFix
 
 BOOST_AUTO_TEST_CASE(TestFibEnumerationPublisher)
 {
+  // FIB entries do not own their nexthop faces
+  std::vector<shared_ptr<DummyFace>> faces;
+
   for (int i = 0; i < 87; i++)
     {
       Name prefix("/test");
@@ -51,10 +54,12 @@ BOOST_AUTO_TEST_CASE(TestFibEnumerationPublisher)
       shared_ptr<DummyFace> dummy2(make_shared<DummyFace>());
 
       shared_ptr<fib::Entry> entry = m_fib.insert(prefix).first;
-      entry->addNextHop(dummy1, std::numeric_limits<uint64_t>::max() - 1);
-      entry->addNextHop(dummy2, std::numeric_limits<uint64_t>::max() - 2);
+      entry->addNextHop(*dummy1, std::numeric_limits<uint64_t>::max() - 1);
+      entry->addNextHop(*dummy2, std::numeric_limits<uint64_t>::max() - 2);
 
       m_referenceEntries.insert(entry);
+      faces.push_back(dummy1);
+      faces.push_back(dummy2);
     }
   for (int i = 0; i < 2; i++)
     {
@@ -65,10 +70,12 @@ BOOST_AUTO_TEST_CASE(TestFibEnumerationPublisher)
       shared_ptr<DummyFace> dummy2(make_shared<DummyFace>());
 
       shared_ptr<fib::Entry> entry = m_fib.insert(prefix).first;
-      entry->addNextHop(dummy1, std::numeric_limits<uint8_t>::max() - 1);
-      entry->addNextHop(dummy2, std::numeric_limits<uint8_t>::max() - 2);
+      entry->addNextHop(*dummy1, std::numeric_limits<uint8_t>::max() - 1);
+      entry->addNextHop(*dummy2, std::numeric_limits<uint8_t>::max() - 2);
 
       m_referenceEntries.insert(entry);
+      faces.push_back(dummy1);
+      faces.push_back(dummy2);
     }
 
   ndn::EncodingBuffer buffer;
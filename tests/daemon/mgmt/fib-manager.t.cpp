@@ -196,7 +196,7 @@ BOOST_FIXTURE_TEST_SUITE(MgmtFibManager, AuthorizedCommandFixture<FibManagerFixt
 bool
 foundNextHop(FaceId id, uint32_t cost, const fib::NextHop& next)
 {
-  return id == next.getFace()->getId() && next.getCost() == cost;
+  return id == next.getFace().getId() && next.getCost() == cost;
 }
 
 bool
@@ -217,7 +217,7 @@ bool
 foundNextHopWithFace(FaceId id, uint32_t cost,
                      shared_ptr<Face> face, const fib::NextHop& next)
 {
-  return id == next.getFace()->getId() && next.getCost() == cost && face == next.getFace();
+  return id == next.getFace().getId() && next.getCost() == cost && face.get() == &next.getFace();
 }
 
 bool
@@ -738,9 +738,9 @@ BOOST_AUTO_TEST_CASE(RemoveNextHop)
 
   shared_ptr<fib::Entry> entry = fib.insert("/hello").first;
 
-  entry->addNextHop(face1, 101);
-  entry->addNextHop(face2, 202);
-  entry->addNextHop(face3, 303);
+  entry->addNextHop(*face1, 101);
+  entry->addNextHop(*face2, 202);
+  entry->addNextHop(*face3, 303);
 
   testRemoveNextHop(this, manager, fib, face, "/hello", 2);
   BOOST_REQUIRE(removedNextHopWithCost(fib, "/hello", 3, 202));
@@ -879,6 +879,9 @@ BOOST_AUTO_TEST_CASE(RemoveImplicitFaceId)
 
 BOOST_FIXTURE_TEST_CASE(TestFibEnumerationRequest, FibManagerFixture)
 {
+  // FIB entries do not own their nexthop faces
+  std::vector<shared_ptr<DummyFace>> faces;
+
   for (int i = 0; i < 87; i++)
     {
       Name prefix("/test");
@@ -888,10 +891,12 @@ BOOST_FIXTURE_TEST_CASE(TestFibEnumerationRequest, FibManagerFixture)
       shared_ptr<DummyFace> dummy2(make_shared<DummyFace>());
 
       shared_ptr<fib::Entry> entry = m_fib.insert(prefix).first;
-      entry->addNextHop(dummy1, std::numeric_limits<uint64_t>::max() - 1);
-      entry->addNextHop(dummy2, std::numeric_limits<uint64_t>::max() - 2);
+      entry->addNextHop(*dummy1, std::numeric_limits<uint64_t>::max() - 1);
+      entry->addNextHop(*dummy2, std::numeric_limits<uint64_t>::max() - 2);
 
       m_referenceEntries.insert(entry);
+      faces.push_back(dummy1);
+      faces.push_back(dummy2);
     }
   for (int i = 0; i < 2; i++)
     {
@@ -902,10 +907,12 @@ BOOST_FIXTURE_TEST_CASE(TestFibEnumerationRequest, FibManagerFixture)
       shared_ptr<DummyFace> dummy2(make_shared<DummyFace>());
 
       shared_ptr<fib::Entry> entry = m_fib.insert(prefix).first;
-      entry->addNextHop(dummy1, std::numeric_limits<uint8_t>::max() - 1);
-      entry->addNextHop(dummy2, std::numeric_limits<uint8_t>::max() - 2);
+      entry->addNextHop(*dummy1, std::numeric_limits<uint8_t>::max() - 1);
+      entry->addNextHop(*dummy2, std::numeric_limits<uint8_t>::max() - 2);
 
       m_referenceEntries.insert(entry);
+      faces.push_back(dummy1);
+      faces.push_back(dummy2);
     }
 
   ndn::EncodingBuffer buffer;
@@ -45,7 +45,8 @@ public:
     , m_fib(m_forwarder.getFib())
     , m_strategyChoice(m_forwarder.getStrategyChoice())
     , m_measurements(m_forwarder.getMeasurements())
-    , m_tablesConfig(m_cs, m_pit, m_fib, m_strategyChoice, m_measurements)
+    , m_deadNonceList(m_forwarder.getDeadNonceList())
+    , m_tablesConfig(m_forwarder)
   {
     m_tablesConfig.setConfigFile(m_config);
   }
@@ -77,6 +78,7 @@ protected:
   Fib& m_fib;
   StrategyChoice& m_strategyChoice;
   Measurements& m_measurements;
+  DeadNonceList& m_deadNonceList;
 
   TablesConfigSection m_tablesConfig;
   ConfigFile m_config;
@@ -178,6 +180,84 @@ BOOST_AUTO_TEST_CASE(InvalidValueCsMaxPackets)
                              this, _1, expectedMsg));
 }
 
+BOOST_AUTO_TEST_CASE(ValidDnlFilterCapacity)
+{
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  dnl_filter_capacity 4096\n"
+    "}\n";
+
+  BOOST_REQUIRE_EQUAL(m_deadNonceList.getFilterCapacity(), 0);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK_EQUAL(m_deadNonceList.getFilterCapacity(), 0);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(m_deadNonceList.getFilterCapacity(), 4096);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidValueDnlFilterCapacity)
+{
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  dnl_filter_capacity invalid\n"
+    "}\n";
+
+  const std::string expectedMsg =
+    "Invalid value for option \"dnl_filter_capacity\" in \"tables\" section";
+
+  BOOST_CHECK_EXCEPTION(runConfig(CONFIG, true),
+                        ConfigFile::Error,
+                        bind(&TablesConfigSectionFixture::validateException,
+                             this, _1, expectedMsg));
+
+  BOOST_CHECK_EXCEPTION(runConfig(CONFIG, false),
+                        ConfigFile::Error,
+                        bind(&TablesConfigSectionFixture::validateException,
+                             this, _1, expectedMsg));
+}
+
+BOOST_AUTO_TEST_CASE(ValidStragglerDuration)
+{
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  straggler_duration 50\n"
+    "}\n";
+
+  BOOST_REQUIRE(m_forwarder.getStragglerDuration() == time::milliseconds(100));
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK(m_forwarder.getStragglerDuration() == time::milliseconds(100));
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK(m_forwarder.getStragglerDuration() == time::milliseconds(50));
+}
+
+BOOST_AUTO_TEST_CASE(InvalidValueStragglerDuration)
+{
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  straggler_duration invalid\n"
+    "}\n";
+
+  const std::string expectedMsg =
+    "Invalid value for option \"straggler_duration\" in \"tables\" section";
+
+  BOOST_CHECK_EXCEPTION(runConfig(CONFIG, true),
+                        ConfigFile::Error,
+                        bind(&TablesConfigSectionFixture::validateException,
+                             this, _1, expectedMsg));
+
+  BOOST_CHECK_EXCEPTION(runConfig(CONFIG, false),
+                        ConfigFile::Error,
+                        bind(&TablesConfigSectionFixture::validateException,
+                             this, _1, expectedMsg));
+}
+
 BOOST_AUTO_TEST_CASE(ConfigStrategy)
 {
   const std::string CONFIG =
@@ -48,6 +48,65 @@ BOOST_AUTO_TEST_CASE(Basic)
   BOOST_CHECK_EQUAL(dnl.has(nameA, nonce1), true);
   BOOST_CHECK_EQUAL(dnl.has(nameA, nonce2), false);
   BOOST_CHECK_EQUAL(dnl.has(nameB, nonce1), false);
+
+  // entries depend on component order, and repeated components do not cancel out
+  dnl.add("ndn:/a/b", nonce1);
+  BOOST_CHECK_EQUAL(dnl.has("ndn:/a/b", nonce1), true);
+  BOOST_CHECK_EQUAL(dnl.has("ndn:/b/a", nonce1), false);
+  dnl.add("ndn:/x/x/y", nonce1);
+  BOOST_CHECK_EQUAL(dnl.has("ndn:/x/x/y", nonce1), true);
+  BOOST_CHECK_EQUAL(dnl.has("ndn:/y", nonce1), false);
+}
+
+BOOST_AUTO_TEST_CASE(BasicFilter)
+{
+  Name nameA("ndn:/A");
+  Name nameB("ndn:/B");
+  const uint32_t nonce1 = 0x53b4eaa8;
+  const uint32_t nonce2 = 0x1f46372b;
+
+  DeadNonceList dnl;
+  dnl.add(nameA, nonce2);
+  dnl.setFilterCapacity(1024);
+  BOOST_CHECK_EQUAL(dnl.getFilterCapacity(), 1024);
+  BOOST_CHECK_EQUAL(dnl.size(), 0);
+  BOOST_CHECK_EQUAL(dnl.has(nameA, nonce2), false);
+
+  dnl.add(nameA, nonce1);
+  BOOST_CHECK_EQUAL(dnl.size(), 1);
+  BOOST_CHECK_EQUAL(dnl.has(nameA, nonce1), true);
+  BOOST_CHECK_EQUAL(dnl.has(nameA, nonce2), false);
+  BOOST_CHECK_EQUAL(dnl.has(nameB, nonce1), false);
+
+  dnl.setFilterCapacity(0);
+  BOOST_CHECK_EQUAL(dnl.size(), 0);
+  BOOST_CHECK_EQUAL(dnl.has(nameA, nonce1), false);
+}
+
+BOOST_AUTO_TEST_CASE(FilterFalsePositiveRate)
+{
+  const size_t CAPACITY = 1 << 14;
+  DeadNonceFilter filter(6, CAPACITY);
+
+  for (uint64_t i = 0; i < CAPACITY; ++i) {
+    BOOST_CHECK(filter.add(i * 0x9e3779b97f4a7c15));
+  }
+  BOOST_CHECK_EQUAL(filter.size(), CAPACITY);
+  BOOST_CHECK_EQUAL(filter.getNOverflows(), 0);
+
+  size_t nFalsePositives = 0;
+  for (uint64_t i = CAPACITY; i < CAPACITY * 2; ++i) {
+    nFalsePositives += filter.has(i * 0x9e3779b97f4a7c15);
+  }
+  BOOST_CHECK_LT(nFalsePositives, CAPACITY / 1000);
+
+  for (size_t i = 0; i < 5; ++i) {
+    filter.rotate();
+    BOOST_CHECK(filter.has(0x9e3779b97f4a7c15));
+  }
+  filter.rotate();
+  BOOST_CHECK_EQUAL(filter.size(), 0);
+  BOOST_CHECK(!filter.has(0x9e3779b97f4a7c15));
 }
 
 BOOST_AUTO_TEST_CASE(MinLifetime)
@@ -153,6 +212,27 @@ BOOST_FIXTURE_TEST_CASE(CapacityUp, PeriodicalInsertionFixture)
   BOOST_CHECK_LT(std::abs(cap1 - RATE), std::abs(cap0 - RATE));
 }
 
+BOOST_FIXTURE_TEST_CASE(LifetimeFilter, PeriodicalInsertionFixture)
+{
+  dnl.setFilterCapacity(DeadNonceList::INITIAL_CAPACITY);
+
+  const int RATE = DeadNonceList::INITIAL_CAPACITY / 2;
+  this->setRate(RATE);
+  this->advanceClocksByLifetime(10.0);
+
+  Name nameC("ndn:/C");
+  const uint32_t nonceC = 0x25390656;
+  BOOST_CHECK_EQUAL(dnl.has(nameC, nonceC), false);
+  dnl.add(nameC, nonceC);
+  BOOST_CHECK_EQUAL(dnl.has(nameC, nonceC), true);
+
+  this->advanceClocksByLifetime(0.5); // -50%, entry should exist
+  BOOST_CHECK_EQUAL(dnl.has(nameC, nonceC), true);
+
+  this->advanceClocksByLifetime(1.0); // +50%, entry should be gone
+  BOOST_CHECK_EQUAL(dnl.has(nameC, nonceC), false);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
@@ -46,21 +46,21 @@ BOOST_AUTO_TEST_CASE(Entry)
   // []
   BOOST_CHECK_EQUAL(nexthops1.size(), 0);
 
-  entry.addNextHop(face1, 20);
+  entry.addNextHop(*face1, 20);
   const fib::NextHopList& nexthops2 = entry.getNextHops();
   // [(face1,20)]
   BOOST_CHECK_EQUAL(nexthops2.size(), 1);
-  BOOST_CHECK_EQUAL(nexthops2.begin()->getFace(), face1);
+  BOOST_CHECK_EQUAL(&nexthops2.begin()->getFace(), face1.get());
   BOOST_CHECK_EQUAL(nexthops2.begin()->getCost(), 20);
 
-  entry.addNextHop(face1, 30);
+  entry.addNextHop(*face1, 30);
   const fib::NextHopList& nexthops3 = entry.getNextHops();
   // [(face1,30)]
   BOOST_CHECK_EQUAL(nexthops3.size(), 1);
-  BOOST_CHECK_EQUAL(nexthops3.begin()->getFace(), face1);
+  BOOST_CHECK_EQUAL(&nexthops3.begin()->getFace(), face1.get());
   BOOST_CHECK_EQUAL(nexthops3.begin()->getCost(), 30);
 
-  entry.addNextHop(face2, 40);
+  entry.addNextHop(*face2, 40);
   const fib::NextHopList& nexthops4 = entry.getNextHops();
   // [(face1,30), (face2,40)]
   BOOST_CHECK_EQUAL(nexthops4.size(), 2);
@@ -70,17 +70,17 @@ BOOST_AUTO_TEST_CASE(Entry)
     ++i;
     switch (i) {
       case 0 :
-        BOOST_CHECK_EQUAL(it->getFace(), face1);
+        BOOST_CHECK_EQUAL(&it->getFace(), face1.get());
         BOOST_CHECK_EQUAL(it->getCost(), 30);
         break;
       case 1 :
-        BOOST_CHECK_EQUAL(it->getFace(), face2);
+        BOOST_CHECK_EQUAL(&it->getFace(), face2.get());
         BOOST_CHECK_EQUAL(it->getCost(), 40);
         break;
     }
   }
 
-  entry.addNextHop(face2, 10);
+  entry.addNextHop(*face2, 10);
   const fib::NextHopList& nexthops5 = entry.getNextHops();
   // [(face2,10), (face1,30)]
   BOOST_CHECK_EQUAL(nexthops5.size(), 2);
@@ -90,11 +90,11 @@ BOOST_AUTO_TEST_CASE(Entry)
     ++i;
     switch (i) {
       case 0 :
-        BOOST_CHECK_EQUAL(it->getFace(), face2);
+        BOOST_CHECK_EQUAL(&it->getFace(), face2.get());
         BOOST_CHECK_EQUAL(it->getCost(), 10);
         break;
       case 1 :
-        BOOST_CHECK_EQUAL(it->getFace(), face1);
+        BOOST_CHECK_EQUAL(&it->getFace(), face1.get());
         BOOST_CHECK_EQUAL(it->getCost(), 30);
         break;
     }
@@ -104,14 +104,14 @@ BOOST_AUTO_TEST_CASE(Entry)
   const fib::NextHopList& nexthops6 = entry.getNextHops();
   // [(face2,10)]
   BOOST_CHECK_EQUAL(nexthops6.size(), 1);
-  BOOST_CHECK_EQUAL(nexthops6.begin()->getFace(), face2);
+  BOOST_CHECK_EQUAL(&nexthops6.begin()->getFace(), face2.get());
   BOOST_CHECK_EQUAL(nexthops6.begin()->getCost(), 10);
 
   entry.removeNextHop(face1);
   const fib::NextHopList& nexthops7 = entry.getNextHops();
   // [(face2,10)]
   BOOST_CHECK_EQUAL(nexthops7.size(), 1);
-  BOOST_CHECK_EQUAL(nexthops7.begin()->getFace(), face2);
+  BOOST_CHECK_EQUAL(&nexthops7.begin()->getFace(), face2.get());
   BOOST_CHECK_EQUAL(nexthops7.begin()->getCost(), 10);
 
   entry.removeNextHop(face2);
@@ -125,6 +125,97 @@ BOOST_AUTO_TEST_CASE(Entry)
   BOOST_CHECK_EQUAL(nexthops9.size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(EntryNextHopOrder)
+{
+  shared_ptr<Face> face1 = make_shared<DummyFace>();
+  shared_ptr<Face> face2 = make_shared<DummyFace>();
+  shared_ptr<Face> face3 = make_shared<DummyFace>();
+  shared_ptr<Face> face4 = make_shared<DummyFace>();
+
+  fib::Entry entry("ndn:/N2hFgx0V");
+  const fib::NextHopList& nexthops = entry.getNextHops();
+  auto getFaces = [&nexthops] {
+    std::vector<shared_ptr<Face>> faces;
+    for (const fib::NextHop& nexthop : nexthops) {
+      faces.push_back(nexthop.getFace().shared_from_this());
+    }
+    return faces;
+  };
+
+  entry.addNextHop(*face1, 20);
+  entry.addNextHop(*face2, 10);
+  entry.addNextHop(*face3, 20);
+  entry.addNextHop(*face4, 30);
+  // [(face2,10), (face1,20), (face3,20), (face4,30)]
+  std::vector<shared_ptr<Face>> expected1{face2, face1, face3, face4};
+  BOOST_CHECK(getFaces() == expected1);
+
+  entry.addNextHop(*face2, 20);
+  // equal cost: face2 stays before face1 and face3
+  // [(face2,20), (face1,20), (face3,20), (face4,30)]
+  BOOST_CHECK(getFaces() == expected1);
+
+  entry.addNextHop(*face1, 25);
+  // [(face2,20), (face3,20), (face1,25), (face4,30)]
+  std::vector<shared_ptr<Face>> expected2{face2, face3, face1, face4};
+  BOOST_CHECK(getFaces() == expected2);
+
+  entry.addNextHop(*face4, 0);
+  // [(face4,0), (face2,20), (face3,20), (face1,25)]
+  std::vector<shared_ptr<Face>> expected3{face4, face2, face3, face1};
+  BOOST_CHECK(getFaces() == expected3);
+
+  entry.addNextHop(*face4, 40);
+  // [(face2,20), (face3,20), (face1,25), (face4,40)]
+  std::vector<shared_ptr<Face>> expected4{face2, face3, face1, face4};
+  BOOST_CHECK(getFaces() == expected4);
+}
+
+BOOST_AUTO_TEST_CASE(NextHopListStorage)
+{
+  std::vector<shared_ptr<Face>> faces;
+  fib::NextHopList nexthops;
+  BOOST_CHECK(nexthops.empty());
+
+  // grow past inline storage
+  for (size_t i = 0; i < fib::NextHopList::INLINE_CAPACITY * 3; ++i) {
+    faces.push_back(make_shared<DummyFace>());
+    fib::NextHop nexthop(*faces.back());
+    nexthop.setCost(i);
+    nexthops.push_back(nexthop);
+  }
+  BOOST_REQUIRE_EQUAL(nexthops.size(), faces.size());
+  for (size_t i = 0; i < faces.size(); ++i) {
+    BOOST_CHECK_EQUAL(&nexthops[i].getFace(), faces[i].get());
+    BOOST_CHECK_EQUAL(nexthops[i].getCost(), i);
+  }
+
+  fib::NextHopList copy(nexthops);
+  BOOST_REQUIRE_EQUAL(copy.size(), faces.size());
+  BOOST_CHECK_EQUAL(&copy[0].getFace(), faces[0].get());
+
+  // erase keeps the order of remaining nexthops
+  fib::NextHopList::iterator it = nexthops.erase(nexthops.begin() + 1);
+  BOOST_CHECK_EQUAL(&it->getFace(), faces[2].get());
+  BOOST_REQUIRE_EQUAL(nexthops.size(), faces.size() - 1);
+  BOOST_CHECK_EQUAL(&nexthops[0].getFace(), faces[0].get());
+  BOOST_CHECK_EQUAL(&nexthops[1].getFace(), faces[2].get());
+  BOOST_CHECK_EQUAL(copy.size(), faces.size());
+
+  // assign a short list over a long list, and the other way around
+  fib::NextHopList small;
+  small.push_back(fib::NextHop(*faces[0]));
+  copy = small;
+  BOOST_REQUIRE_EQUAL(copy.size(), 1);
+  BOOST_CHECK_EQUAL(&copy[0].getFace(), faces[0].get());
+  small = nexthops;
+  BOOST_CHECK_EQUAL(small.size(), nexthops.size());
+
+  nexthops.clear();
+  BOOST_CHECK(nexthops.empty());
+  BOOST_CHECK(nexthops.begin() == nexthops.end());
+}
+
 BOOST_AUTO_TEST_CASE(Insert_LongestPrefixMatch)
 {
   Name nameEmpty;
@@ -214,37 +305,37 @@ BOOST_AUTO_TEST_CASE(RemoveNextHopFromAllEntries)
   // {}
 
   insertRes = fib.insert(nameA);
-  insertRes.first->addNextHop(face1, 0);
-  insertRes.first->addNextHop(face2, 0);
+  insertRes.first->addNextHop(*face1, 0);
+  insertRes.first->addNextHop(*face2, 0);
   // {'/A':[1,2]}
 
   insertRes = fib.insert(nameB);
-  insertRes.first->addNextHop(face1, 0);
+  insertRes.first->addNextHop(*face1, 0);
   // {'/A':[1,2], '/B':[1]}
   BOOST_CHECK_EQUAL(fib.size(), 2);
 
   insertRes = fib.insert("/C");
-  insertRes.first->addNextHop(face2, 1);
+  insertRes.first->addNextHop(*face2, 1);
   // {'/A':[1,2], '/B':[1], '/C':[2]}
   BOOST_CHECK_EQUAL(fib.size(), 3);
 
   insertRes = fib.insert("/B/1");
-  insertRes.first->addNextHop(face1, 0);
+  insertRes.first->addNextHop(*face1, 0);
   // {'/A':[1,2], '/B':[1], '/B/1':[1], '/C':[2]}
   BOOST_CHECK_EQUAL(fib.size(), 4);
 
   insertRes = fib.insert("/B/1/2");
-  insertRes.first->addNextHop(face1, 0);
+  insertRes.first->addNextHop(*face1, 0);
   // {'/A':[1,2], '/B':[1], '/B/1':[1], '/B/1/2':[1], '/C':[2]}
   BOOST_CHECK_EQUAL(fib.size(), 5);
 
   insertRes = fib.insert("/B/1/2/3");
-  insertRes.first->addNextHop(face1, 0);
+  insertRes.first->addNextHop(*face1, 0);
   // {'/A':[1,2], '/B':[1], '/B/1':[1], '/B/1/2':[1], '/B/1/3':[1], '/C':[2]}
   BOOST_CHECK_EQUAL(fib.size(), 6);
 
   insertRes = fib.insert("/B/1/2/3/4");
-  insertRes.first->addNextHop(face1, 0);
+  insertRes.first->addNextHop(*face1, 0);
   // {'/A':[1,2], '/B':[1], '/B/1':[1], '/B/1/2':[1], '/B/1/2/3':[1], '/B/1/2/3/4':[1], '/C':[2]}
   BOOST_CHECK_EQUAL(fib.size(), 7);
 
@@ -258,7 +349,7 @@ BOOST_AUTO_TEST_CASE(RemoveNextHopFromAllEntries)
   BOOST_CHECK_EQUAL(entry->getPrefix(), nameA);
   const fib::NextHopList& nexthopsA = entry->getNextHops();
   BOOST_CHECK_EQUAL(nexthopsA.size(), 1);
-  BOOST_CHECK_EQUAL(nexthopsA.begin()->getFace(), face2);
+  BOOST_CHECK_EQUAL(&nexthopsA.begin()->getFace(), face2.get());
 
   entry = fib.findLongestPrefixMatch(nameB);
   BOOST_CHECK_EQUAL(entry->getPrefix(), nameEmpty);
@@ -272,7 +363,7 @@ BOOST_AUTO_TEST_CASE(RemoveNextHopFromManyEntries)
 
   for (uint64_t i = 0; i < 300; ++i) {
     shared_ptr<fib::Entry> entry = fib.insert(Name("/P").appendVersion(i)).first;
-    entry->addNextHop(face1, 0);
+    entry->addNextHop(*face1, 0);
   }
   BOOST_CHECK_EQUAL(fib.size(), 300);
 
@@ -280,6 +371,51 @@ BOOST_AUTO_TEST_CASE(RemoveNextHopFromManyEntries)
   BOOST_CHECK_EQUAL(fib.size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(FaceIndex)
+{
+  NameTree nameTree;
+  Fib fib(nameTree);
+  shared_ptr<Face> face1 = make_shared<DummyFace>();
+  shared_ptr<Face> face2 = make_shared<DummyFace>();
+
+  shared_ptr<fib::Entry> entryA = fib.insert("/A").first;
+  entryA->addNextHop(*face1, 0);
+  entryA->addNextHop(*face2, 0);
+  entryA->addNextHop(*face1, 10); // update cost only
+  shared_ptr<fib::Entry> entryB = fib.insert("/B").first;
+  entryB->addNextHop(*face1, 0);
+  // {'/A':[1,2], '/B':[1]}
+  BOOST_CHECK_EQUAL(fib.countEntriesByNextHop(*face1), 2);
+  BOOST_CHECK_EQUAL(fib.countEntriesByNextHop(*face2), 1);
+
+  std::vector<shared_ptr<fib::Entry>> entries = fib.findEntriesByNextHop(*face2);
+  BOOST_REQUIRE_EQUAL(entries.size(), 1);
+  BOOST_CHECK_EQUAL(entries.front(), entryA);
+
+  entryA->removeNextHop(face1);
+  // {'/A':[2], '/B':[1]}
+  BOOST_CHECK_EQUAL(fib.countEntriesByNextHop(*face1), 1);
+  entries = fib.findEntriesByNextHop(*face1);
+  BOOST_REQUIRE_EQUAL(entries.size(), 1);
+  BOOST_CHECK_EQUAL(entries.front(), entryB);
+
+  fib.erase(*entryA);
+  // {'/B':[1]}
+  BOOST_CHECK_EQUAL(entryA->hasNextHops(), false);
+  BOOST_CHECK_EQUAL(fib.countEntriesByNextHop(*face2), 0);
+  BOOST_CHECK(fib.findEntriesByNextHop(*face2).empty());
+
+  // erased entry no longer updates the index
+  entryA->addNextHop(*face2, 0);
+  BOOST_CHECK_EQUAL(fib.countEntriesByNextHop(*face2), 0);
+  fib.removeNextHopFromAllEntries(face2);
+  BOOST_CHECK_EQUAL(entryA->getNextHops().size(), 1);
+
+  fib.removeNextHopFromAllEntries(face1);
+  BOOST_CHECK_EQUAL(fib.size(), 0);
+  BOOST_CHECK_EQUAL(fib.countEntriesByNextHop(*face1), 0);
+}
+
 void
 validateFindExactMatch(const Fib& fib, const Name& target)
 {
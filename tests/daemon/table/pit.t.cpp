@@ -208,6 +208,24 @@ BOOST_AUTO_TEST_CASE(EntryNonce)
                     pit::DUPLICATE_NONCE_OUT_SAME | pit::DUPLICATE_NONCE_OUT_OTHER);
   BOOST_CHECK_EQUAL(entry5.findNonce(19004, *face1), pit::DUPLICATE_NONCE_NONE);
   BOOST_CHECK_EQUAL(entry5.findNonce(19004, *face2), pit::DUPLICATE_NONCE_NONE);
+
+  // Nonce is forgotten after its records are deleted
+  pit::Entry entry6(*interest);
+  entry6.insertOrUpdateInRecord(face1, *interest);
+  entry6.insertOrUpdateOutRecord(face2, *interest);
+  entry6.deleteInRecords();
+  BOOST_CHECK_EQUAL(entry6.findNonce(25559, *face1), pit::DUPLICATE_NONCE_OUT_OTHER);
+  entry6.deleteOutRecord(*face2);
+  BOOST_CHECK_EQUAL(entry6.findNonce(25559, *face1), pit::DUPLICATE_NONCE_NONE);
+
+  // Nonce replaced by an update is not found
+  shared_ptr<Interest> interest2 = makeInterest("ndn:/qtCQ7I1c");
+  interest2->setNonce(19004);
+  pit::Entry entry7(*interest);
+  entry7.insertOrUpdateInRecord(face1, *interest);
+  entry7.insertOrUpdateInRecord(face1, *interest2);
+  BOOST_CHECK_EQUAL(entry7.findNonce(25559, *face1), pit::DUPLICATE_NONCE_NONE);
+  BOOST_CHECK_EQUAL(entry7.findNonce(19004, *face1), pit::DUPLICATE_NONCE_IN_SAME);
 }
 
 BOOST_AUTO_TEST_CASE(EntryLifetime)
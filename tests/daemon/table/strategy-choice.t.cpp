@@ -124,6 +124,42 @@ BOOST_AUTO_TEST_CASE(Effective)
   BOOST_CHECK_EQUAL(table.findEffectiveStrategy("ndn:/D")  .getName(), nameQ);
 }
 
+BOOST_AUTO_TEST_CASE(EffectiveCached)
+{
+  Forwarder forwarder;
+  Name nameP("ndn:/strategy/P");
+  Name nameQ("ndn:/strategy/Q");
+  shared_ptr<Strategy> strategyP = make_shared<DummyStrategy>(ref(forwarder), nameP);
+  shared_ptr<Strategy> strategyQ = make_shared<DummyStrategy>(ref(forwarder), nameQ);
+
+  StrategyChoice& table = forwarder.getStrategyChoice();
+  Pit& pit = forwarder.getPit();
+  table.install(strategyP);
+  table.install(strategyQ);
+
+  BOOST_CHECK(table.insert("ndn:/", nameP));
+  // { '/'=>P }
+
+  shared_ptr<Interest> interest = makeInterest("ndn:/A/B");
+  shared_ptr<pit::Entry> pitEntry = pit.insert(*interest).first;
+  BOOST_CHECK_EQUAL(&table.findEffectiveStrategy(*pitEntry), strategyP.get());
+  // cached result
+  BOOST_CHECK_EQUAL(&table.findEffectiveStrategy(*pitEntry), strategyP.get());
+
+  BOOST_CHECK(table.insert("ndn:/A", nameQ));
+  // { '/'=>P, '/A'=>Q }
+  BOOST_CHECK_EQUAL(&table.findEffectiveStrategy(*pitEntry), strategyQ.get());
+
+  BOOST_CHECK(table.insert("ndn:/A", nameP));
+  // { '/'=>P, '/A'=>P }
+  BOOST_CHECK_EQUAL(&table.findEffectiveStrategy(*pitEntry), strategyP.get());
+
+  BOOST_CHECK(table.insert("ndn:/", nameQ));
+  table.erase("ndn:/A");
+  // { '/'=>Q }
+  BOOST_CHECK_EQUAL(&table.findEffectiveStrategy(*pitEntry), strategyQ.get());
+}
+
 //XXX BOOST_CONCEPT_ASSERT((ForwardIterator<std::vector<int>::iterator>))
 //    is also failing. There might be a problem with ForwardIterator concept checking.
 //BOOST_CONCEPT_ASSERT((ForwardIterator<StrategyChoice::const_iterator>));
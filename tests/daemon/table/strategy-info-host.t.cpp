@@ -75,6 +75,23 @@ public:
   int m_id;
 };
 
+class DummyStrategyInfo3 : public StrategyInfo
+{
+public:
+  static constexpr int
+  getTypeId()
+  {
+    return 3;
+  }
+
+  DummyStrategyInfo3(int id)
+    : m_id(id)
+  {
+  }
+
+  int m_id;
+};
+
 BOOST_FIXTURE_TEST_SUITE(TableStrategyInfoHost, BaseFixture)
 
 BOOST_AUTO_TEST_CASE(SetGetClear)
@@ -134,6 +151,53 @@ BOOST_AUTO_TEST_CASE(Types)
   BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo>()->m_id, 8063);
 }
 
+BOOST_AUTO_TEST_CASE(UnsetOneType)
+{
+  StrategyInfoHost host;
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfo2>() == nullptr);
+
+  host.setStrategyInfo<DummyStrategyInfo2>(nullptr); // no-op when nothing is stored
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfo2>() == nullptr);
+
+  host.getOrCreateStrategyInfo<DummyStrategyInfo>(4721);
+  host.getOrCreateStrategyInfo<DummyStrategyInfo2>(6150);
+
+  host.setStrategyInfo<DummyStrategyInfo>(nullptr);
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfo>() == nullptr);
+  BOOST_REQUIRE(host.getStrategyInfo<DummyStrategyInfo2>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo2>()->m_id, 6150);
+}
+
+BOOST_AUTO_TEST_CASE(MoreTypesThanInline)
+{
+  StrategyInfoHost host;
+
+  host.getOrCreateStrategyInfo<DummyStrategyInfo>(1585);
+  host.getOrCreateStrategyInfo<DummyStrategyInfo2>(3047);
+  host.getOrCreateStrategyInfo<DummyStrategyInfo3>(7726);
+  BOOST_REQUIRE(host.getStrategyInfo<DummyStrategyInfo>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo>()->m_id, 1585);
+  BOOST_REQUIRE(host.getStrategyInfo<DummyStrategyInfo2>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo2>()->m_id, 3047);
+  BOOST_REQUIRE(host.getStrategyInfo<DummyStrategyInfo3>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo3>()->m_id, 7726);
+
+  // freeing an inline item must not hide or duplicate the overflowed one
+  host.setStrategyInfo<DummyStrategyInfo>(nullptr);
+  host.getOrCreateStrategyInfo<DummyStrategyInfo3>(4410);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo3>()->m_id, 7726);
+  host.setStrategyInfo<DummyStrategyInfo3>(nullptr);
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfo3>() == nullptr);
+
+  StrategyInfoHost copy(host);
+  BOOST_REQUIRE(copy.getStrategyInfo<DummyStrategyInfo2>() != nullptr);
+  BOOST_CHECK_EQUAL(copy.getStrategyInfo<DummyStrategyInfo2>()->m_id, 3047);
+
+  host.clearStrategyInfo();
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfo2>() == nullptr);
+  BOOST_CHECK(copy.getStrategyInfo<DummyStrategyInfo2>() != nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core/scheduler.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+class SchedulerBenchmarkFixture : public BaseFixture
+{
+protected:
+  SchedulerBenchmarkFixture()
+  {
+#ifdef _DEBUG
+    BOOST_TEST_MESSAGE("Benchmark compiled in debug mode is unreliable, "
+                       "please compile in release mode.");
+#endif // _DEBUG
+  }
+
+  ~SchedulerBenchmarkFixture()
+  {
+    ns3::Simulator::Destroy();
+  }
+
+  time::microseconds
+  timedRun(std::function<void()> f)
+  {
+    time::steady_clock::TimePoint t1 = time::steady_clock::now();
+    f();
+    time::steady_clock::TimePoint t2 = time::steady_clock::now();
+    return time::duration_cast<time::microseconds>(t2 - t1);
+  }
+
+  /** \return a spread of delays resembling PIT entry lifetimes
+   */
+  static std::vector<time::nanoseconds>
+  makeDelays(size_t count)
+  {
+    std::vector<time::nanoseconds> delays(count);
+    for (size_t i = 0; i < count; ++i) {
+      delays[i] = time::milliseconds(100 + (i * 7919) % 4000);
+    }
+    return delays;
+  }
+
+protected:
+  static const size_t N_TIMERS = 1000000;
+};
+
+BOOST_FIXTURE_TEST_SUITE(CoreSchedulerBenchmark, SchedulerBenchmarkFixture)
+
+// schedule, then cancel before expiry
+BOOST_AUTO_TEST_CASE(ScheduleCancel)
+{
+  std::vector<time::nanoseconds> delays = makeDelays(N_TIMERS);
+  std::vector<scheduler::EventId> events(N_TIMERS);
+
+  time::microseconds d = timedRun([&] {
+    for (size_t i = 0; i < N_TIMERS; ++i) {
+      events[i] = scheduler::schedule(delays[i], bind([]{}));
+    }
+    for (size_t i = 0; i < N_TIMERS; ++i) {
+      scheduler::cancel(events[i]);
+    }
+    ns3::Simulator::Run();
+  });
+  BOOST_TEST_MESSAGE("schedule-cancel " << N_TIMERS << ": " << d);
+}
+
+// schedule, then let every timer expire
+BOOST_AUTO_TEST_CASE(ScheduleExpire)
+{
+  std::vector<time::nanoseconds> delays = makeDelays(N_TIMERS);
+  size_t nExpired = 0;
+
+  time::microseconds d = timedRun([&] {
+    for (size_t i = 0; i < N_TIMERS; ++i) {
+      scheduler::schedule(delays[i], [&nExpired] { ++nExpired; });
+    }
+    ns3::Simulator::Run();
+  });
+  BOOST_CHECK_EQUAL(nExpired, N_TIMERS);
+  BOOST_TEST_MESSAGE("schedule-expire " << N_TIMERS << ": " << d);
+}
+
+// 90% of timers are cancelled and rescheduled, as PIT timers are on Data arrival
+BOOST_AUTO_TEST_CASE(Mixed)
+{
+  std::vector<time::nanoseconds> delays = makeDelays(N_TIMERS);
+  std::vector<scheduler::EventId> events(N_TIMERS);
+  size_t nExpired = 0;
+
+  time::microseconds d = timedRun([&] {
+    for (size_t i = 0; i < N_TIMERS; ++i) {
+      events[i] = scheduler::schedule(delays[i], [&nExpired] { ++nExpired; });
+      if (i % 10 != 0) {
+        scheduler::cancel(events[i]);
+        events[i] = scheduler::schedule(time::milliseconds(100), [&nExpired] { ++nExpired; });
+      }
+    }
+    ns3::Simulator::Run();
+  });
+  BOOST_CHECK_EQUAL(nExpired, N_TIMERS);
+  BOOST_TEST_MESSAGE("schedule-cancel-schedule " << N_TIMERS << ": " << d);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd